@@ -37,6 +37,17 @@ concept SpaceDerivableIvpDerivative = IvpDerivative<D> && requires(D f,
   { f.pdvx(t, x) } -> std::same_as<Matrixd<D::kDim, D::kDim>>;
 };
 
+/**
+ * An IvpDerivative that is also derivable with respect to time,
+ * with x fixed, as the Rosenbrock methods need
+ * for the problems that are not autonomous.
+ */
+template <typename D>
+concept TimeDerivableIvpDerivative = IvpDerivative<D> && requires(D f,
+    const double t, const Vectord<D::kDim>& x) {
+  { f.pdvt(t, x) } -> std::same_as<Vectord<D::kDim>>;
+};
+
 /**
  * An IvpDerivative that is also derivable up to some order
  * when viewed as a function from time domain to the space domain,
@@ -0,0 +1,159 @@
+#ifndef INCLUDE_METHODS_ADAMS_NORDSIECK_HPP_
+#define INCLUDE_METHODS_ADAMS_NORDSIECK_HPP_
+
+#include <algorithm>
+#include "initial_value_problem.hpp"
+#include "tools/polynomial.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Variable Order Adams Method in Nordsieck Form
+ * The Adams-Moulton methods of orders 1 to MaxOrder,
+ * with the corrector solved by fixed point iteration
+ * from the Taylor prediction, as in Hindmarsh's LSODE.
+ * See NordsieckMethod and NordsieckStepper.
+ *
+ * The history is a polynomial that interpolates the point
+ * and the derivatives at the last q points. The coefficients
+ * are computed from the actual distances between those points,
+ * as in CVODE, so changing the step size does not disturb
+ * the error estimates of the next steps.
+ * Only suited for nonstiff problems.
+ */
+template <int MaxOrder = 12>
+struct AdamsNordsieck {
+  static_assert(1 <= MaxOrder && MaxOrder <= 12);
+  static constexpr int kMaxOrder = MaxOrder;
+  static constexpr bool kDerivativeNodes = true;
+
+  using Coefficients = Polynomial<MaxOrder+2>;
+
+  /**
+   * The primitive of prod_{i=1}^{q-1} (1 + x/(1 + xi[i-1]))
+   * that vanishes at -1, which corrects z[0] with the integral
+   * of the derivatives over the step and keeps the rest
+   * at the last q-1 derivatives.
+   */
+  static constexpr Coefficients corrector(int q, const double* xi) {
+    Coefficients p{1};
+    for (int i = 1; i < q; ++i) {
+      p = MultiplyByLinear(p, 1, 1/(1 + xi[i-1]));
+    }
+    Coefficients l = Primitive(p);
+    l[0] = -Evaluate(l, -1);
+    return l;
+  }
+
+  /**
+   * The primitive of prod_{i=0}^{q-1} (x + xi[i]) that vanishes at 0.
+   * It keeps z[0] and the last q derivatives.
+   */
+  static constexpr Coefficients raiser(int q, const double* xi) {
+    Coefficients p{1};
+    for (int i = 0; i < q; ++i) {
+      p = MultiplyByLinear(p, xi[i], 1);
+    }
+    return Primitive(p);
+  }
+
+  /**
+   * q times the primitive of prod_{i=0}^{q-2} (x + xi[i])
+   * that vanishes at 0. It has degree q and keeps z[0]
+   * and the last q-1 derivatives.
+   */
+  static constexpr Coefficients lowerer(int q, const double* xi) {
+    Coefficients p{1};
+    for (int i = 0; i < q-1; ++i) {
+      p = MultiplyByLinear(p, xi[i], 1);
+    }
+    Coefficients d = Primitive(p);
+    for (double& c : d) {
+      c *= q;
+    }
+    return d;
+  }
+
+  /**
+   * The local error of order q over the size of the correction,
+   * |∫_{-1}^0 prod_{i=0}^{q-1} (x + ξ_i)| / prod_{i=1}^q ξ_i,
+   * where ξ_0 = 0 and ξ_i = 1 + xi[i-1] are the distances
+   * from the new point. With constant steps, it is errorConstant[q].
+   */
+  static constexpr double errorCoefficient(int q, const double* xi) {
+    Coefficients p{0, 1};
+    double den = 1 + xi[q-1];
+    for (int i = 1; i < q; ++i) {
+      p = MultiplyByLinear(p, 1 + xi[i-1], 1);
+      den *= 1 + xi[i-1];
+    }
+    double c = Evaluate(Primitive(p), -1);
+    return (c < 0? -c : c)/den;
+  }
+
+  /**
+   * |γ*_q| of the constant step methods,
+   * from γ*_0 = 1 and γ*_q = -sum_{i=1}^q γ*_{q-i}/(i+1).
+   */
+  static constexpr Coefficients errorConstant = [] {
+    Coefficients gamma{1};
+    for (int q = 1; q <= MaxOrder+1; ++q) {
+      for (int i = 1; i <= q; ++i) {
+        gamma[q] -= gamma[q-i]/(i+1);
+      }
+    }
+    for (double& c : gamma) {
+      c = c < 0? -c : c;
+    }
+    return gamma;
+  }();
+
+  /**
+   * Fixed point iteration of the corrector, while the corrections
+   * shrink fast enough to fall below a fraction of the tolerance
+   * in at most kMaxIterations evaluations.
+   * The rate of convergence is kept for the next steps.
+   * It always takes two evaluations, since stopping after the first one
+   * leaves the derivative at the predicted point in the history,
+   * which is unstable on oscillatory problems from order 5.
+   */
+  template <int N>
+  class Corrector {
+   public:
+    template <IvpDerivative D>
+    bool correct(const D& f, double t, const Vectord<N>* z, double h, int q,
+        const Coefficients& l, Vectord<N>& e, double tol) {
+      double bound = 0.5/(q+2)*h*tol/errorConstant[q];
+      e.setZero();
+      Vectord<N> y = z[0];
+      double del1 = 0;
+      for (int m = 0; m < kMaxIterations; ++m) {
+        Vectord<N> d = h*f(t, y) - z[1] - e;
+        e += d;
+        double del = d.norm();
+        if (m > 0) {
+          crate_ = std::max(0.2*crate_, del/del1);
+          if (del*std::min(1.0, 1.5*crate_) <= bound) {
+            return true;
+          }
+          if (del > 2*del1) {
+            return false;
+          }
+        }
+        y = z[0] + l[0]*e;
+        del1 = del;
+      }
+      return false;
+    }
+
+   private:
+    static constexpr int kMaxIterations = 3;
+
+    double crate_ = 0.7;
+  };
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_ADAMS_NORDSIECK_HPP_
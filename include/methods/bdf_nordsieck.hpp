@@ -0,0 +1,192 @@
+#ifndef INCLUDE_METHODS_BDF_NORDSIECK_HPP_
+#define INCLUDE_METHODS_BDF_NORDSIECK_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include "Eigen/LU"
+#include "initial_value_problem.hpp"
+#include "tools/jacobian.hpp"
+#include "tools/polynomial.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Variable Order Backward Differentiation Formulas in Nordsieck Form
+ * The BDFs of orders 1 to MaxOrder for variable steps,
+ * with the corrector solved by a simplified Newton iteration
+ * that reuses the Jacobian and its LU decomposition
+ * between steps, as in Brown, Byrne and Hindmarsh's VODE.
+ * See NordsieckMethod and NordsieckStepper.
+ *
+ * The history is the polynomial that interpolates the last q+1 points,
+ * and the new point is the one where its derivative is f.
+ * The coefficients are computed from the actual distances between
+ * the points, so the method is the variable coefficient BDF.
+ * Suited for stiff problems. The Jacobian is the one of the problem
+ * if it is a SpaceDerivableIvpDerivative, and a finite difference
+ * approximation otherwise.
+ */
+template <int MaxOrder = 5>
+struct BdfNordsieck {
+  static_assert(1 <= MaxOrder && MaxOrder <= 5);
+  static constexpr int kMaxOrder = MaxOrder;
+  static constexpr bool kDerivativeNodes = false;
+
+  using Coefficients = Polynomial<MaxOrder+2>;
+
+  /**
+   * prod_{i=1}^q (1 + x/(1 + xi[i-1])), which moves the new point
+   * and keeps the last q points.
+   */
+  static constexpr Coefficients corrector(int q, const double* xi) {
+    Coefficients l{1};
+    for (int i = 1; i <= q; ++i) {
+      l = MultiplyByLinear(l, 1, 1/(1 + xi[i-1]));
+    }
+    return l;
+  }
+
+  /**
+   * prod_{i=0}^q (x + xi[i]), which keeps the last q+1 points.
+   */
+  static constexpr Coefficients raiser(int q, const double* xi) {
+    Coefficients p{1};
+    for (int i = 0; i <= q; ++i) {
+      p = MultiplyByLinear(p, xi[i], 1);
+    }
+    return p;
+  }
+
+  /**
+   * prod_{i=0}^{q-1} (x + xi[i]), of degree q,
+   * which keeps the last q points.
+   */
+  static constexpr Coefficients lowerer(int q, const double* xi) {
+    Coefficients p{1};
+    for (int i = 0; i < q; ++i) {
+      p = MultiplyByLinear(p, xi[i], 1);
+    }
+    return p;
+  }
+
+  /**
+   * The local error of order q over the size of the correction,
+   * 1 / (l[1] ξ_{q+1}), where ξ_i = 1 + xi[i-1] are the distances
+   * from the new point. With constant steps, it is errorConstant[q].
+   */
+  static constexpr double errorCoefficient(int q, const double* xi) {
+    double l1 = 0;
+    for (int i = 1; i <= q; ++i) {
+      l1 += 1/(1 + xi[i-1]);
+    }
+    return 1/(l1*(1 + xi[q]));
+  }
+
+  /**
+   * 1/((q+1) sum_{i=1}^q 1/i) for the constant step methods.
+   */
+  static constexpr Coefficients errorConstant = [] {
+    Coefficients c{1};
+    double harmonic = 0;
+    for (int q = 1; q <= MaxOrder+1; ++q) {
+      harmonic += 1.0/q;
+      c[q] = 1/((q+1)*harmonic);
+    }
+    return c;
+  }();
+
+  /**
+   * Simplified Newton iteration of the corrector,
+   * solving l[1] e = h f(z[0] + e) - z[1] for the change e of the point,
+   * while the corrections shrink fast enough to fall below a fraction
+   * of the tolerance in at most kMaxIterations iterations.
+   *
+   * The matrix I - γ J, with γ = h/l[1], is decomposed again when γ
+   * changes by more than 30%, and the Jacobian J is evaluated again
+   * every kMaxAge steps and when the iteration fails with an old one.
+   */
+  template <int N>
+  class Corrector {
+   public:
+    template <IvpDerivative D>
+    bool correct(const D& f, double t, const Vectord<N>* z, double h, int q,
+        const Coefficients& l, Vectord<N>& e, double tol) {
+      double gamma = h/l[1];
+      bool fresh = false;
+      if (age_ >= kMaxAge) {
+        jacobian(f, t, z[0]);
+        fresh = true;
+      }
+      if (fresh || std::abs(gamma/gamma_ - 1) > 0.3) {
+        decompose(gamma);
+      }
+      ++age_;
+      while (!iterate(f, t, z, h, q, l, e, tol)) {
+        if (fresh) {
+          return false;
+        }
+        jacobian(f, t, z[0]);
+        decompose(gamma);
+        fresh = true;
+      }
+      return true;
+    }
+
+   private:
+    static constexpr int kMaxIterations = 4;
+    static constexpr int kMaxAge = 20;
+
+    template <IvpDerivative D>
+    bool iterate(const D& f, double t, const Vectord<N>* z, double h, int q,
+        const Coefficients& l, Vectord<N>& e, double tol) {
+      double bound = 0.5/(q+2)*h*tol/errorConstant[q];
+      // The decomposition is for gamma_, which the corrections
+      // overshoot or undershoot by about the ratio of the gammas
+      double scale = 2/(1 + h/l[1]/gamma_);
+      e.setZero();
+      Vectord<N> y = z[0];
+      double del1 = 0;
+      for (int m = 0; m < kMaxIterations; ++m) {
+        Vectord<N> d = scale*lu_.solve((h*f(t, y) - z[1])/l[1] - e);
+        e += d;
+        y = z[0] + e;
+        double del = d.norm();
+        if (m > 0) {
+          crate_ = std::max(0.2*crate_, del/del1);
+        }
+        if (del*std::min(1.0, 1.5*crate_) <= bound) {
+          return true;
+        }
+        if (m > 0 && del > 2*del1) {
+          return false;
+        }
+        del1 = del;
+      }
+      return false;
+    }
+
+    template <IvpDerivative D>
+    void jacobian(const D& f, double t, const Vectord<N>& x) {
+      jac_ = Jacobian(f, t, x);
+      age_ = 0;
+      crate_ = 0.7;
+    }
+
+    void decompose(double gamma) {
+      gamma_ = gamma;
+      lu_.compute(Matrixd<N, N>::Identity(jac_.rows(), jac_.cols())
+          - gamma*jac_);
+    }
+
+    Matrixd<N, N> jac_;
+    Eigen::PartialPivLU<Matrixd<N, N>> lu_;
+    double gamma_ = 1;
+    int age_ = kMaxAge;
+    double crate_ = 0.7;
+  };
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_BDF_NORDSIECK_HPP_
@@ -0,0 +1,50 @@
+#ifndef INCLUDE_METHODS_CARPENTER_KENNEDY_4_HPP_
+#define INCLUDE_METHODS_CARPENTER_KENNEDY_4_HPP_
+
+#include "methods/low_storage_runge_kutta.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of Carpenter and Kennedy's fourth order, five stage,
+ * low storage method, the solution 3 of their report (1994).
+ */
+struct CarpenterKennedy4Tableau {
+  static constexpr int kOrder = 4;
+  static constexpr int kStages = 5;
+  static constexpr double A[] = {
+    0,
+    -567301805773/1357537059087.0,
+    -2404267990393/2016746695238.0,
+    -3550918686646/2091501179385.0,
+    -1275806237668/842570457699.0
+  };
+  static constexpr double B[] = {
+    1432997174477/9575080441755.0,
+    5161836677717/13612068292357.0,
+    1720146321549/2090206949498.0,
+    3134564353537/4481467310338.0,
+    2277821191437/14882151754819.0
+  };
+  static constexpr double c[] = {
+    0,
+    1432997174477/9575080441755.0,
+    2526269341429/6820363962896.0,
+    2006345519317/3224310063776.0,
+    2802321613138/2924317926251.0
+  };
+};
+
+/**
+ * Carpenter and Kennedy's Fourth Order Low Storage Runge-Kutta Method
+ *
+ * Computes a fourth order approximation using 5 evaluations,
+ * one more than RK4, but keeping only two vectors of the size
+ * of the problem instead of six. Its stability region is also larger,
+ * so its steps can be longer on method of lines discretizations.
+ */
+using CarpenterKennedy4 = LowStorageRungeKutta<CarpenterKennedy4Tableau>;
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_CARPENTER_KENNEDY_4_HPP_
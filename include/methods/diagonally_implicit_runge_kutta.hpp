@@ -0,0 +1,229 @@
+#ifndef INCLUDE_METHODS_DIAGONALLY_IMPLICIT_RUNGE_KUTTA_HPP_
+#define INCLUDE_METHODS_DIAGONALLY_IMPLICIT_RUNGE_KUTTA_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <utility>
+#include "Eigen/LU"
+#include "initial_value_problem.hpp"
+#include "tools/jacobian.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * DiagonallyImplicitTableau
+ * The coefficients of a diagonally implicit Runge-Kutta method
+ * of kStages stages, given as constexpr class variables.
+ * Every diagonal coefficient a[i][i] is gamma (SDIRK),
+ * or every one but the first, which is explicit, with a[0][0] = c[0] = 0
+ * (ESDIRK). Only the lower triangle of a is used.
+ * b gives the solution and bHat the embedded one,
+ * and kOrder is the order of the error estimate, the lower of both.
+ */
+template <typename T>
+concept DiagonallyImplicitTableau = requires {
+  { T::kOrder } -> std::same_as<const int&>;
+  { T::kStages } -> std::same_as<const int&>;
+  { T::gamma } -> std::convertible_to<double>;
+  { T::a[T::kStages-1][T::kStages-1] } -> std::convertible_to<double>;
+  { T::b[T::kStages-1] } -> std::convertible_to<double>;
+  { T::bHat[T::kStages-1] } -> std::convertible_to<double>;
+  { T::c[T::kStages-1] } -> std::convertible_to<double>;
+};
+
+/**
+ * Diagonally Implicit Runge-Kutta Method
+ * An adaptive implicit method defined by a DiagonallyImplicitTableau.
+ *
+ * The stages are solved one after the other by simplified Newton
+ * iteration, each from the derivative of the previous one.
+ * Since they share the diagonal, they share the decomposition
+ * of I - h gamma J, which is only redone when the step size changes.
+ * The step is kept while it would grow by less than kHoldStepRatio,
+ * as in RADAU5, and the Jacobian is reused between steps while the
+ * iteration converges fast. See CachingAdaptiveMethod.
+ * The error estimate is filtered by (I - h gamma J)^-1, as Shampine
+ * proposes, so that it stays bounded on the stiff components.
+ */
+template <DiagonallyImplicitTableau T>
+struct DiagonallyImplicitRungeKutta {
+  static constexpr int kOrder = T::kOrder;
+  static constexpr int kStages = T::kStages;
+  // The error is bounded per step, as in RADAU5, see AllowedError
+  static constexpr bool kErrorPerStep = true;
+  /**
+   * The step size is kept, with its decomposition,
+   * when the next one would be at most this many times larger.
+   */
+  static constexpr double kHoldStepRatio = 1.2;
+
+  /**
+   * What is reused between steps: the Jacobian, the decomposition
+   * for the last step size and the rate of convergence of the iteration.
+   */
+  template <int N>
+  class Cache {
+   public:
+    inline void accept() {}
+
+   private:
+    friend struct DiagonallyImplicitRungeKutta;
+
+    Matrixd<N, N> jac_;
+    Eigen::PartialPivLU<Matrixd<N, N>> lu_;
+    // Step of the decomposition, 0 if it is outdated
+    double hLu_ = 0;
+    bool stale_ = true;
+    bool fresh_ = false;
+    double faccon_ = 1;
+  };
+
+  /**
+   * A step without reusing anything from the previous ones.
+   */
+  template <IvpDerivative D>
+  inline std::pair<Vectord<D::kDim>, double> step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance) const {
+    Cache<D::kDim> cache;
+    return cached_step(f, t, x, h, tolerance, cache);
+  }
+
+  /**
+   * Solves the stages with a new Jacobian if the one of the cache
+   * is stale or the iteration fails with it. If it fails with a new one,
+   * the step is rejected with an infinite error.
+   * Then the step size is multiplied by
+   * (tolerance*(1 + |x|)/(2*error))^(1/(kOrder+1)),
+   * within [0.1, 4], unless that is in [1, kHoldStepRatio].
+   */
+  template <IvpDerivative D>
+  std::pair<Vectord<D::kDim>, double> cached_step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance,
+      Cache<D::kDim>& cache) const {
+    constexpr int N = D::kDim;
+    Vectord<N> dv = f(t, x);
+    cache.fresh_ = false;
+    if (cache.stale_) {
+      jacobian(f, t, x, dv, cache);
+    }
+    std::array<Vectord<N>, kStages> k;
+    while (!stages(f, t, x, h, tolerance, dv, k.data(), cache)) {
+      if (cache.fresh_) {
+        h *= 0.5;
+        return {x, std::numeric_limits<double>::infinity()};
+      }
+      jacobian(f, t, x, dv, cache);
+    }
+
+    Vectord<N> y = x;
+    Vectord<N> e = Vectord<N>::Zero(x.size());
+    for (int j = 0; j < kStages; ++j) {
+      if (T::b[j] != 0) {
+        y += (T::b[j]*h)*k[j];
+      }
+      if (T::b[j] != T::bHat[j]) {
+        e += ((T::b[j] - T::bHat[j])*h)*k[j];
+      }
+    }
+    double error = cache.lu_.solve(e).norm();
+    double allowed = tolerance*(1 + x.norm());
+    if (error >= allowed) {
+      cache.stale_ = !cache.fresh_;
+    }
+    double q = std::pow(allowed/(2*error), 1.0/(kOrder+1));
+    q = std::max(0.1, std::min(q, 4.0));
+    if (q < 1 || q > kHoldStepRatio) {
+      h *= q;
+    }
+    return {y, error};
+  }
+
+ private:
+  static constexpr int kMaxIterations = 7;
+  // Fraction of the tolerance for the iteration
+  static constexpr double kNewtonTol = 0.03;
+  // The Jacobian is kept while the iteration converges faster than this
+  static constexpr double kReuseRate = 0.1;
+
+  template <IvpDerivative D>
+  static inline void jacobian(const D& f, double t, const Vectord<D::kDim>& x,
+      const Vectord<D::kDim>& dv, Cache<D::kDim>& cache) {
+    cache.jac_ = Jacobian(f, t, x, dv);
+    cache.stale_ = false;
+    cache.fresh_ = true;
+    cache.hLu_ = 0;
+  }
+
+  /**
+   * Computes the derivatives k at the stages of the step of size h
+   * from (t, x), where dv is the derivative at (t, x).
+   * Solves k[i] = f(t + c[i] h, x + h sum_{j<=i} a[i][j] k[j])
+   * for each implicit stage, while the corrections shrink fast enough
+   * to fall below a fraction of the tolerance
+   * in at most kMaxIterations iterations.
+   * Returns whether every stage converged.
+   */
+  template <IvpDerivative D>
+  static bool stages(const D& f, double t, const Vectord<D::kDim>& x,
+      double h, double tol, const Vectord<D::kDim>& dv, Vectord<D::kDim>* k,
+      Cache<D::kDim>& cache) {
+    constexpr int N = D::kDim;
+    double hg = h*T::gamma;
+    if (cache.hLu_ != h) {
+      cache.lu_.compute(Matrixd<N, N>::Identity(x.size(), x.size())
+          - hg*cache.jac_);
+      cache.hLu_ = h;
+    }
+    double bound = kNewtonTol*tol*(1 + x.norm());
+    double faccon = std::pow(std::max(cache.faccon_,
+        std::numeric_limits<double>::epsilon()), 0.8);
+    double slowest = 0;
+    Vectord<N> base(x.size());
+    for (int i = 0; i < kStages; ++i) {
+      base = x;
+      for (int j = 0; j < i; ++j) {
+        if (T::a[i][j] != 0) {
+          base += (T::a[i][j]*h)*k[j];
+        }
+      }
+      double ti = t + T::c[i]*h;
+      if (T::a[i][i] == 0) {
+        k[i] = i == 0? dv : f(ti, base);
+        continue;
+      }
+      k[i] = i == 0? dv : k[i-1];
+      bool converged = false;
+      double del1 = 0;
+      for (int m = 0; m < kMaxIterations && !converged; ++m) {
+        Vectord<N> d = cache.lu_.solve(f(ti, base + hg*k[i]) - k[i]);
+        k[i] += d;
+        double del = hg*d.norm();
+        if (m > 0) {
+          double theta = del/del1;
+          if (theta >= 0.99) {
+            break;
+          }
+          faccon = theta/(1 - theta);
+          slowest = std::max(slowest, theta);
+        }
+        converged = faccon*del <= bound;
+        del1 = del;
+      }
+      if (!converged) {
+        cache.faccon_ = 1;
+        return false;
+      }
+    }
+    cache.faccon_ = faccon;
+    cache.stale_ = slowest > kReuseRate;
+    return true;
+  }
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_DIAGONALLY_IMPLICIT_RUNGE_KUTTA_HPP_
@@ -0,0 +1,118 @@
+#ifndef INCLUDE_METHODS_DORMAND_PRINCE_54_HPP_
+#define INCLUDE_METHODS_DORMAND_PRINCE_54_HPP_
+
+#include "initial_value_problem.hpp"
+#include "methods/explicit_runge_kutta.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of the Dormand-Prince 5(4) Method.
+ * b gives the fifth order solution and bHat the fourth order one.
+ * The last row of a is b, so the last stage is the derivative
+ * at the new point (FSAL).
+ *
+ *   0  ┃
+ *  1/5 ┃ 1/5
+ * 3/10 ┃ 3/40        9/40
+ *  4/5 ┃ 44/45       -56/15       32/9
+ *  8/9 ┃ 19372/6561  -25360/2187  64448/6561  -212/729
+ *   1  ┃ 9017/3168   -355/33      46732/5247  49/176   -5103/18656
+ *   1  ┃ 35/384      0            500/1113    125/192  -2187/6784    11/84
+ * ━━━━━╋━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *      ┃ 35/384      0            500/1113    125/192  -2187/6784    11/84
+ *      ┃ 5179/57600  0            7571/16695  393/640  -92097/339200
+ *      ┃                                                 187/2100  1/40
+ */
+struct DormandPrince54Tableau {
+  static constexpr int kOrder = 4;
+  static constexpr int kStages = 7;
+  static constexpr double c[] = {0, 1/5.0, 3/10.0, 4/5.0, 8/9.0, 1, 1};
+  static constexpr double a[7][7] = {
+    {},
+    {1/5.0},
+    {3/40.0, 9/40.0},
+    {44/45.0, -56/15.0, 32/9.0},
+    {19372/6561.0, -25360/2187.0, 64448/6561.0, -212/729.0},
+    {9017/3168.0, -355/33.0, 46732/5247.0, 49/176.0, -5103/18656.0},
+    {35/384.0, 0, 500/1113.0, 125/192.0, -2187/6784.0, 11/84.0},
+  };
+  static constexpr double b[] = {35/384.0, 0, 500/1113.0, 125/192.0,
+      -2187/6784.0, 11/84.0, 0};
+  static constexpr double bHat[] = {5179/57600.0, 0, 7571/16695.0,
+      393/640.0, -92097/339200.0, 187/2100.0, 1/40.0};
+};
+
+/**
+ * Dormand-Prince 5(4) Method
+ * An adaptive Runge-Kutta method
+ *
+ * Like Fehlberg's method, advances with a fifth order solution
+ * and estimates the error with an embedded fourth order one,
+ * but its coefficients minimize the error of the fifth order solution.
+ * It has 7 stages, but the last one is the derivative at the new point,
+ * which is the first stage of the next step, so the solvers only evaluate
+ * 6 derivatives per step. See FsalAdaptiveMethod.
+ */
+struct DormandPrince54 : ExplicitRungeKutta<DormandPrince54Tableau> {
+  // Order of the continuous extension
+  static constexpr int kDenseOrder = 4;
+
+  /**
+   * The continuous extension of a step of the Dormand-Prince method,
+   * which needs no evaluation besides the stages of the step.
+   *
+   * With th = (t - t0)/h and th1 = 1 - th,
+   * x(t) = r0 + th (r1 + th1 (r2 + th (r3 + th1 r4))),
+   * where r0..r4 are computed once per step (Hairer, Nørsett and Wanner's
+   * DOPRI5). It is of fourth order and matches the values
+   * and the derivatives at both ends of the step.
+   */
+  template <int N>
+  struct Interpolant {
+    inline Vectord<N> operator()(double t) const {
+      double th = (t - t0)/h;
+      double th1 = 1 - th;
+      return r[0] + th*(r[1] + th1*(r[2] + th*(r[3] + th1*r[4])));
+    }
+
+    double t0;
+    double h;
+    Vectord<N> r[5];
+  };
+
+  /**
+   * Returns the continuous extension of the step of size h from (t, x),
+   * given the derivatives dv at its start and dv1 at its end.
+   */
+  template <IvpDerivative D>
+  inline Interpolant<D::kDim> interpolant(D f, double t,
+      const Vectord<D::kDim>& x, const Vectord<D::kDim>& dv, double h,
+      const Vectord<D::kDim>& dv1) const {
+    constexpr double d1 = -12715105075/11282082432.0;
+    constexpr double d3 = 87487479700/32700410799.0;
+    constexpr double d4 = -10690763975/1880347072.0;
+    constexpr double d5 = 701980252875/199316789632.0;
+    constexpr double d6 = -1453857185/822651844.0;
+    constexpr double d7 = 69997945/29380423.0;
+    Vectord<D::kDim> k[kStages];
+    // The last stage is dv1
+    stages<kStages-1>(f, t, x, h, dv, k);
+    k[6] = dv1;
+    Interpolant<D::kDim> in{t, h};
+    constexpr const double* b = DormandPrince54Tableau::b;
+    Vectord<D::kDim> dx = h*(b[0]*k[0] + b[2]*k[2] + b[3]*k[3] + b[4]*k[4]
+        + b[5]*k[5]);
+    in.r[0] = x;
+    in.r[1] = dx;
+    in.r[2] = h*k[0] - dx;
+    in.r[3] = dx - h*k[6] - in.r[2];
+    in.r[4] = h*(d1*k[0] + d3*k[2] + d4*k[3] + d5*k[4] + d6*k[5] + d7*k[6]);
+    return in;
+  }
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_DORMAND_PRINCE_54_HPP_
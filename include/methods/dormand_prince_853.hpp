@@ -0,0 +1,172 @@
+#ifndef INCLUDE_METHODS_DORMAND_PRINCE_853_HPP_
+#define INCLUDE_METHODS_DORMAND_PRINCE_853_HPP_
+
+#include "initial_value_problem.hpp"
+#include "methods/explicit_runge_kutta.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of the Dormand-Prince 8(5,3) Method, as given by Hairer,
+ * Nørsett and Wanner for DOP853.
+ * b gives the eighth order solution and b - e a fifth order one.
+ * The third order estimate of DOP853 is not used,
+ * so the error is the difference with the fifth order solution.
+ */
+struct DormandPrince853Tableau {
+  static constexpr int kOrder = 5;
+  static constexpr int kStages = 12;
+  static constexpr double c[] = {
+    0, 0.05260015195876773, 0.0789002279381516, 0.1183503419072274,
+    0.2816496580927726, 0.3333333333333333, 0.25, 0.3076923076923077,
+    0.6512820512820513, 0.6, 0.8571428571428571, 1
+  };
+  static constexpr double a[12][12] = {
+    {},
+    {0.05260015195876773},
+    {0.0197250569845379, 0.0591751709536137},
+    {0.02958758547680685, 0, 0.08876275643042054},
+    {0.2413651341592667, 0, -0.8845494793282861, 0.924834003261792},
+    {0.037037037037037035, 0, 0, 0.17082860872947386, 0.12546768756682242},
+    {0.037109375, 0, 0, 0.17025221101954405, 0.06021653898045596, -0.017578125},
+    {0.03709200011850479, 0, 0, 0.17038392571223998, 0.10726203044637328,
+     -0.015319437748624402, 0.008273789163814023},
+    {0.6241109587160757, 0, 0, -3.3608926294469414, -0.868219346841726,
+     27.59209969944671, 20.154067550477894, -43.48988418106996},
+    {0.47766253643826434, 0, 0, -2.4881146199716677, -0.590290826836843,
+     21.230051448181193, 15.279233632882423, -33.28821096898486,
+     -0.020331201708508627},
+    {-0.9371424300859873, 0, 0, 5.186372428844064, 1.0914373489967295,
+     -8.149787010746927, -18.52006565999696, 22.739487099350505,
+     2.4936055526796523, -3.0467644718982196},
+    {2.273310147516538, 0, 0, -10.53449546673725, -2.0008720582248625,
+     -17.9589318631188, 27.94888452941996, -2.8589982771350235,
+     -8.87285693353063, 12.360567175794303, 0.6433927460157636},
+  };
+  static constexpr double b[] = {
+    0.054293734116568765, 0, 0, 0, 0, 4.450312892752409, 1.8915178993145003,
+    -5.801203960010585, 0.3111643669578199, -0.1521609496625161,
+    0.20136540080403034, 0.04471061572777259
+  };
+  static constexpr double e[] = {
+    0.01312004499419488, 0, 0, 0, 0, -1.2251564463762044, -0.4957589496572502,
+    1.6643771824549864, -0.35032884874997366, 0.3341791187130175,
+    0.08192320648511571, -0.022355307863886294
+  };
+  static constexpr double bHat[] = {
+    b[0] - e[0], 0, 0, 0, 0, b[5] - e[5], b[6] - e[6], b[7] - e[7],
+    b[8] - e[8], b[9] - e[9], b[10] - e[10], b[11] - e[11]
+  };
+};
+
+/**
+ * Dormand-Prince 8(5,3) Method
+ * An adaptive Runge-Kutta method of order 8
+ *
+ * Advances with an eighth order solution of 12 stages,
+ * whose error is estimated with an embedded fifth order one.
+ * At tight tolerances it takes far fewer steps than the methods
+ * of order 4 or 5, which makes up for its cost per step.
+ */
+struct DormandPrince853 : ExplicitRungeKutta<DormandPrince853Tableau> {
+  // Order of the continuous extension
+  static constexpr int kDenseOrder = 7;
+
+  /**
+   * The continuous extension of a step of the Dormand-Prince 8(5,3) method.
+   *
+   * With th = (t - t0)/h and th1 = 1 - th,
+   * x(t) = r0 + th (r1 + th1 (r2 + th (r3 + th1 (r4 + th (r5
+   *     + th1 (r6 + th r7)))))),
+   * where r0..r7 are computed once per step from the 12 stages,
+   * the derivative at the end of the step and 3 more stages
+   * (Hairer, Nørsett and Wanner's DOP853).
+   */
+  template <int N>
+  struct Interpolant {
+    inline Vectord<N> operator()(double t) const {
+      double th = (t - t0)/h;
+      double th1 = 1 - th;
+      Vectord<N> y = r[4] + th*(r[5] + th1*(r[6] + th*r[7]));
+      return r[0] + th*(r[1] + th1*(r[2] + th*(r[3] + th1*y)));
+    }
+
+    double t0;
+    double h;
+    Vectord<N> r[8];
+  };
+
+  /**
+   * Returns the continuous extension of the step of size h from (t, x),
+   * given the derivatives dv at its start and dv1 at its end.
+   */
+  template <IvpDerivative D>
+  inline Interpolant<D::kDim> interpolant(D f, double t,
+      const Vectord<D::kDim>& x, const Vectord<D::kDim>& dv, double h,
+      const Vectord<D::kDim>& dv1) const {
+    Vectord<D::kDim> k[16];
+    stages(f, t, x, h, dv, k);
+    k[12] = dv1;
+    Vectord<D::kDim> y(x.size());
+    Unroll<3>([&](auto i) {
+      constexpr int s = 13 + i;
+      Combine<s>(x, h, k, [](auto j) { return kDenseA[s-13][j]; }, y);
+      k[s] = f(t + kDenseC[i]*h, y);
+    });
+
+    Interpolant<D::kDim> in{t, h};
+    auto zero = Vectord<D::kDim>::Zero(x.size());
+    in.r[1] = WeightedSum<12>(zero, h, k,
+        [](auto j) { return DormandPrince853Tableau::b[j]; });
+    in.r[0] = x;
+    in.r[2] = h*k[0] - in.r[1];
+    in.r[3] = in.r[1] - h*k[12] - in.r[2];
+    Unroll<4>([&](auto i) {
+      in.r[4 + i] = WeightedSum<16>(zero, h, k,
+          [](auto j) { return kDenseD[decltype(i)()][j]; });
+    });
+    return in;
+  }
+
+  // Nodes and rows of the 3 stages of the continuous extension,
+  // which follow the derivative at the end of the step
+  static constexpr double kDenseC[] = {
+    0.1, 0.2, 0.7777777777777778
+  };
+  static constexpr double kDenseA[3][15] = {
+    {0.056167502283047954, 0, 0, 0, 0, 0, 0.25350021021662483,
+     -0.2462390374708025, -0.12419142326381637, 0.15329179827876568,
+     0.00820105229563469, 0.007567897660545699, -0.008298},
+    {0.03183464816350214, 0, 0, 0, 0, 0.028300909672366776,
+     0.053541988307438566, -0.05492374857139099, 0, 0,
+     -0.00010834732869724932, 0.0003825710908356584, -0.00034046500868740456,
+     0.1413124436746325},
+    {-0.42889630158379194, 0, 0, 0, 0, -4.697621415361164, 7.683421196062599,
+     4.06898981839711, 0.3567271874552811, 0, 0, 0, -0.0013990241651590145,
+     2.9475147891527724, -9.15095847217987},
+  };
+  // Coefficients of r4..r7
+  static constexpr double kDenseD[4][16] = {
+    {-8.428938276109013, 0, 0, 0, 0, 0.5667149535193777, -3.0689499459498917,
+     2.38466765651207, 2.117034582445028, -0.871391583777973,
+     2.2404374302607883, 0.6315787787694688, -0.08899033645133331,
+     18.148505520854727, -9.194632392478356, -4.436036387594894},
+    {10.427508642579134, 0, 0, 0, 0, 242.28349177525817, 165.20045171727028,
+     -374.5467547226902, -22.113666853125306, 7.733432668472264,
+     -30.674084731089398, -9.332130526430229, 15.697238121770845,
+     -31.139403219565178, -9.35292435884448, 35.81684148639408},
+    {19.985053242002433, 0, 0, 0, 0, -387.0373087493518, -189.17813819516758,
+     527.8081592054236, -11.57390253995963, 6.8812326946963,
+     -1.0006050966910838, 0.7777137798053443, -2.778205752353508,
+     -60.19669523126412, 84.32040550667716, 11.99229113618279},
+    {-25.69393346270375, 0, 0, 0, 0, -154.18974869023643, -231.5293791760455,
+     357.6391179106141, 93.40532418362432, -37.45832313645163,
+     104.0996495089623, 29.8402934266605, -43.53345659001114,
+     96.32455395918828, -39.17726167561544, -149.72683625798564},
+  };
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_DORMAND_PRINCE_853_HPP_
@@ -0,0 +1,46 @@
+#ifndef INCLUDE_METHODS_ESDIRK_32_HPP_
+#define INCLUDE_METHODS_ESDIRK_32_HPP_
+
+#include "methods/diagonally_implicit_runge_kutta.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of Kennedy and Carpenter's ESDIRK3(2)4L[2]SA,
+ * the implicit part of their ARK3(2)4L[2]SA (2003).
+ * b gives the third order solution and bHat the second order one.
+ * The last row of a is b, so the method is stiffly accurate.
+ */
+struct Esdirk32Tableau {
+  static constexpr int kOrder = 2;
+  static constexpr int kStages = 4;
+  static constexpr double gamma = 1767732205903/4055673282236.0;
+  static constexpr double a[4][4] = {
+    {0},
+    {gamma, gamma},
+    {2746238789719/10658868560708.0, -640167445237/6845629431997.0, gamma},
+    {1471266399579/7840856788654.0, -4482444167858/7529755066697.0,
+     11266239266428/11593286722821.0, gamma},
+  };
+  static constexpr double b[] = {
+    1471266399579/7840856788654.0, -4482444167858/7529755066697.0,
+    11266239266428/11593286722821.0, gamma
+  };
+  static constexpr double bHat[] = {
+    2756255671327/12835298489170.0, -10771552573575/22201958757719.0,
+    9247589265047/10645013368117.0, 2193209047091/5459859503100.0
+  };
+  static constexpr double c[] = {0, 2*gamma, 3/5.0, 1};
+};
+
+/**
+ * ESDIRK3(2)
+ * An adaptive diagonally implicit method of order 3
+ *
+ * L-stable, with an explicit first stage and three implicit ones.
+ */
+using Esdirk32 = DiagonallyImplicitRungeKutta<Esdirk32Tableau>;
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_ESDIRK_32_HPP_
@@ -0,0 +1,47 @@
+#ifndef INCLUDE_METHODS_ESDIRK_43_HPP_
+#define INCLUDE_METHODS_ESDIRK_43_HPP_
+
+#include "methods/diagonally_implicit_runge_kutta.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of Kennedy and Carpenter's ESDIRK4(3)6L[2]SA,
+ * the implicit part of their ARK4(3)6L[2]SA (2003), with gamma = 1/4.
+ * b gives the fourth order solution and bHat the third order one.
+ * The last row of a is b, so the method is stiffly accurate.
+ */
+struct Esdirk43Tableau {
+  static constexpr int kOrder = 3;
+  static constexpr int kStages = 6;
+  static constexpr double gamma = 1/4.0;
+  static constexpr double a[6][6] = {
+    {0},
+    {gamma, gamma},
+    {8611/62500.0, -1743/31250.0, gamma},
+    {5012029/34652500.0, -654441/2922500.0, 174375/388108.0, gamma},
+    {15267082809/155376265600.0, -71443401/120774400.0,
+     730878875/902184768.0, 2285395/8070912.0, gamma},
+    {82889/524892.0, 0, 15625/83664.0, 69875/102672.0, -2260/8211.0, gamma},
+  };
+  static constexpr double b[] = {
+    82889/524892.0, 0, 15625/83664.0, 69875/102672.0, -2260/8211.0, gamma
+  };
+  static constexpr double bHat[] = {
+    4586570599/29645900160.0, 0, 178811875/945068544.0,
+    814220225/1159782912.0, -3700637/11593932.0, 61727/225920.0
+  };
+  static constexpr double c[] = {0, 1/2.0, 83/250.0, 31/50.0, 17/20.0, 1};
+};
+
+/**
+ * ESDIRK4(3)
+ * An adaptive diagonally implicit method of order 4
+ *
+ * L-stable, with an explicit first stage and five implicit ones.
+ */
+using Esdirk43 = DiagonallyImplicitRungeKutta<Esdirk43Tableau>;
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_ESDIRK_43_HPP_
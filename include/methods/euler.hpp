@@ -1,11 +1,25 @@
 #ifndef INCLUDE_METHODS_EULER_HPP_
 #define INCLUDE_METHODS_EULER_HPP_
 
-#include "initial_value_problem.hpp"
-#include "types.hpp"
+#include "methods/explicit_runge_kutta.hpp"
 
 namespace odelib {
 
+/**
+ * Tableau of Euler's Method.
+ *
+ *  0 ┃
+ * ━━━╋━━━
+ *    ┃ 1
+ */
+struct EulerTableau {
+  static constexpr int kOrder = 1;
+  static constexpr int kStages = 1;
+  static constexpr double c[] = {0};
+  static constexpr double a[1][1] = {};
+  static constexpr double b[] = {1};
+};
+
 /**
  * Euler's Method
  * The most basic method, a simple Runge-Kutta method of order 1.
@@ -13,21 +27,7 @@ namespace odelib {
  * 
  * x_{n+1} = x_n + h*f(t_n, x_n)
  */
-struct Euler {
-  static constexpr int kOrder = 1;
-
-  template <IvpDerivative D>
-  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
-      double h) const {
-    return hinted_step(f, t, x, h, f(t, x));
-  }
-
-  template <IvpDerivative D>
-  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
-      double h, const Vectord<D::kDim>& dv) const {
-    return x + dv*h;
-  }
-};
+using Euler = ExplicitRungeKutta<EulerTableau>;
 
 }  // namespace odelib
 
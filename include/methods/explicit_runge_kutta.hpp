@@ -0,0 +1,250 @@
+#ifndef INCLUDE_METHODS_EXPLICIT_RUNGE_KUTTA_HPP_
+#define INCLUDE_METHODS_EXPLICIT_RUNGE_KUTTA_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <utility>
+#include "initial_value_problem.hpp"
+#include "tools/unroll.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * ButcherTableau
+ * The coefficients of an explicit Runge-Kutta method of kStages stages,
+ * given as constexpr class variables:
+ *
+ *  c[0]   ┃
+ *  c[1]   ┃ a[1][0]
+ *  ...    ┃ ...
+ *  c[s-1] ┃ a[s-1][0] ... a[s-1][s-2]
+ * ━━━━━━━━╋━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *         ┃ b[0]      ...  b[s-1]
+ *
+ * Only the strictly lower triangle of a is used and c[0] must be 0.
+ */
+template <typename T>
+concept ButcherTableau = requires {
+  { T::kOrder } -> std::same_as<const int&>;
+  { T::kStages } -> std::same_as<const int&>;
+  { T::a[T::kStages-1][T::kStages-1] } -> std::convertible_to<double>;
+  { T::b[T::kStages-1] } -> std::convertible_to<double>;
+  { T::c[T::kStages-1] } -> std::convertible_to<double>;
+};
+
+/**
+ * EmbeddedButcherTableau
+ * A ButcherTableau with a second row of weights, bHat, whose difference
+ * with the solution estimates the error of the step.
+ * kOrder is the order of that estimate, the lower of both orders.
+ */
+template <typename T>
+concept EmbeddedButcherTableau = ButcherTableau<T> && requires {
+  { T::bHat[T::kStages-1] } -> std::convertible_to<double>;
+};
+
+/**
+ * PolynomialInterpolant
+ * The continuous extension of a step from (t0, x0) of size h
+ * whose weights are polynomials of degree D in th = (t - t0)/h,
+ * x(t) = x0 + th r[0] + th^2 r[1] + ... + th^D r[D-1].
+ */
+template <int N, int D>
+struct PolynomialInterpolant {
+  inline Vectord<N> operator()(double t) const {
+    double th = (t - t0)/h;
+    Vectord<N> y = r[D-1];
+    Unroll<D-1>([&](auto p) {
+      y = r[D-2 - p] + th*y;
+    });
+    return x0 + th*y;
+  }
+
+  double t0;
+  double h;
+  Vectord<N> x0;
+  Vectord<N> r[D];
+};
+
+/**
+ * Explicit Runge-Kutta Method
+ * A method defined by a ButcherTableau.
+ *
+ * The stages are unrolled at compile time and the null coefficients
+ * of the tableau are skipped, so each stage costs the same
+ * as a handwritten one.
+ * It is a PlainMethod and, if the tableau is embedded,
+ * a PlainAdaptiveMethod too.
+ */
+template <ButcherTableau T>
+struct ExplicitRungeKutta {
+  static constexpr int kOrder = T::kOrder;
+  static constexpr int kStages = T::kStages;
+  /**
+   * Whether the last stage is evaluated at the new point, "first same as
+   * last", so that it is the first stage of the next step.
+   */
+  static constexpr bool kFsal = [] {
+    constexpr int s = T::kStages;
+    if (T::c[s-1] != 1 || T::b[s-1] != 0) {
+      return false;
+    }
+    for (int j = 0; j < s-1; ++j) {
+      if (T::a[s-1][j] != T::b[j]) {
+        return false;
+      }
+    }
+    return true;
+  }();
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
+      double h) const {
+    return hinted_step(f, t, x, h, f(t, x));
+  }
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
+      double h, const Vectord<D::kDim>& dv) const {
+    std::array<Vectord<D::kDim>, kStages> k;
+    stages(f, t, x, h, dv, k.data());
+    Vectord<D::kDim> y(x.size());
+    Combine<kStages>(x, h, k.data(), [](auto j) { return T::b[j]; }, y);
+    return y;
+  }
+
+  /**
+   * Advances with the weights b and estimates the error with bHat.
+   * Then the step size is multiplied by (tolerance*h/(2*error))^(1/kOrder),
+   * within [0.1, 4].
+   */
+  template <IvpDerivative D>
+  requires EmbeddedButcherTableau<T>
+  inline std::pair<Vectord<D::kDim>, double> step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance) const {
+    std::array<Vectord<D::kDim>, kStages> k;
+    return adaptive_step(f, t, x, h, tolerance, f(t, x), k.data());
+  }
+
+  /**
+   * The adaptive step of a tableau with the FSAL property,
+   * given the derivative dv at (t, x).
+   * The derivative at the new point is the last stage and is written
+   * into dv1, to be the hint of the next step if this one is accepted.
+   */
+  template <IvpDerivative D>
+  requires (EmbeddedButcherTableau<T> && kFsal)
+  inline std::pair<Vectord<D::kDim>, double> hinted_step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance,
+      const Vectord<D::kDim>& dv, Vectord<D::kDim>& dv1) const {
+    std::array<Vectord<D::kDim>, kStages> k;
+    auto result = adaptive_step(f, t, x, h, tolerance, dv, k.data());
+    dv1 = k[kStages-1];
+    return result;
+  }
+
+ protected:
+  /**
+   * Computes the derivatives k[0..S-1] at the first S stages of the step,
+   * where k[0] = dv is the derivative at (t, x).
+   */
+  template <int S = kStages, IvpDerivative D>
+  inline void stages(D f, double t, const Vectord<D::kDim>& x, double h,
+      const Vectord<D::kDim>& dv, Vectord<D::kDim>* k) const {
+    k[0] = dv;
+    Vectord<D::kDim> y(x.size());
+    Unroll<S-1>([&](auto i1) {
+      constexpr int i = i1 + 1;
+      Combine<i>(x, h, k, [](auto j) { return T::a[i][j]; }, y);
+      // Copied, since moving a fixed size vector swaps it with k[i]
+      k[i].noalias() = f(t + T::c[i]*h, y);
+    });
+  }
+
+  /**
+   * The adaptive step from (t, x), given the derivative dv there,
+   * leaving the derivatives at its stages in k.
+   */
+  template <IvpDerivative D>
+  requires EmbeddedButcherTableau<T>
+  inline std::pair<Vectord<D::kDim>, double> adaptive_step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance,
+      const Vectord<D::kDim>& dv, Vectord<D::kDim>* k) const {
+    stages(f, t, x, h, dv, k);
+    Vectord<D::kDim> y(x.size());
+    Combine<kStages>(x, h, k, [](auto j) { return T::b[j]; }, y);
+    double error = WeightedSum<kStages>(Vectord<D::kDim>::Zero(x.size()),
+        h, k, [](auto j) { return T::b[j] - T::bHat[j]; }).norm();
+    double q = std::pow(tolerance * h / (2*error), 1.0/kOrder);
+    q = std::max(0.1, std::min(q, 4.0));
+    h *= q;
+    return {y, error};
+  }
+
+  /**
+   * Returns the continuous extension of the step of size h from (t, x)
+   * with the derivatives k[0..S-1], where the weight of k[i]
+   * is the polynomial sum_p beta(i, p) th^(p+1) of degree D.
+   * beta maps each stage and power to a constant.
+   */
+  template <int S, int D, int N, typename Beta>
+  static inline PolynomialInterpolant<N, D> MakeInterpolant(double t,
+      const Vectord<N>& x, double h, const Vectord<N>* k, Beta beta) {
+    PolynomialInterpolant<N, D> in{t, h, x};
+    Unroll<D>([&](auto p) {
+      in.r[p] = WeightedSum<S>(Vectord<N>::Zero(x.size()), h, k,
+          [](auto i) { return Beta{}(i, decltype(p)()); });
+    });
+    return in;
+  }
+
+  /**
+   * Computes y = x + h*sum w(j) k[j] for the first J stages,
+   * skipping the null weights. w maps each stage to a constant.
+   */
+  template <int J, int N, typename W>
+  static inline void Combine(const Vectord<N>& x, double h,
+      const Vectord<N>* k, W w, Vectord<N>& y) {
+    y = WeightedSum<J>(x, h, k, w);
+  }
+
+  /**
+   * The expression acc + h*sum w(j) k[j] for the first J stages,
+   * skipping the null weights. It is a single sum, so that it is
+   * evaluated in one pass over the vectors, without temporaries.
+   */
+  template <int J, int N, typename E, typename W>
+  static inline auto WeightedSum(const E& acc, double h,
+      const Vectord<N>* k, W w) {
+    static constexpr auto kIdx = NonzeroStages<J, W>();
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+      return (acc + ... + ((W{}(kIdx[I])*h)*k[kIdx[I]]));
+    }(std::make_index_sequence<kIdx.size()>());
+  }
+
+  // The stages among the first J whose weight is not null
+  template <int J, typename W>
+  static constexpr auto NonzeroStages() {
+    constexpr int n = [] {
+      int n = 0;
+      for (int j = 0; j < J; ++j) {
+        n += W{}(j) != 0;
+      }
+      return n;
+    }();
+    std::array<int, n> idx{};
+    for (int j = 0, i = 0; j < J; ++j) {
+      if (W{}(j) != 0) {
+        idx[i++] = j;
+      }
+    }
+    return idx;
+  }
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_EXPLICIT_RUNGE_KUTTA_HPP_
@@ -1,12 +1,44 @@
 #ifndef INCLUDE_METHODS_FEHLBERG_HPP_
 #define INCLUDE_METHODS_FEHLBERG_HPP_
 
-#include <algorithm>
-#include <utility>
+#include "initial_value_problem.hpp"
+#include "methods/explicit_runge_kutta.hpp"
 #include "types.hpp"
 
 namespace odelib {
 
+/**
+ * Tableau of Fehlberg's Method.
+ * b gives the fifth order solution and bHat the fourth order one.
+ *
+ *    0   ┃
+ *   1/4  ┃    1/4
+ *   3/8  ┃    3/32       9/32
+ *  12/13 ┃ 1932/2197 -7200/2197  7296/2197
+ *    1   ┃  439/216      -8      3680/513    -845/4104
+ *   1/2  ┃   -8/27        2     -3544/2565   1859/4104   -11/40
+ * ━━━━━━━╋━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *        ┃   16/135       0     6656/12825  28561/56430   -9/50   2/55
+ *        ┃   25/216       0     1408/2565    2197/4104    -1/5     0
+ */
+struct FehlbergTableau {
+  static constexpr int kOrder = 4;
+  static constexpr int kStages = 6;
+  static constexpr double c[] = {0, 1/4.0, 3/8.0, 12/13.0, 1, 1/2.0};
+  static constexpr double a[6][6] = {
+    {},
+    {1/4.0},
+    {3/32.0, 9/32.0},
+    {1932/2197.0, -7200/2197.0, 7296/2197.0},
+    {439/216.0, -8, 3680/513.0, -845/4104.0},
+    {-8/27.0, 2, -3544/2565.0, 1859/4104.0, -11/40.0},
+  };
+  static constexpr double b[] = {16/135.0, 0, 6656/12825.0, 28561/56430.0,
+      -9/50.0, 2/55.0};
+  static constexpr double bHat[] = {25/216.0, 0, 1408/2565.0, 2197/4104.0,
+      -1/5.0, 0};
+};
+
 /**
  * Fehlberg's Method
  * An adaptive Runge-Kutta method
@@ -17,31 +49,53 @@ namespace odelib {
  * a fifth order Runge-Kutta method and
  * an estimate of the error.
  */
-struct Fehlberg {
-  static constexpr int kOrder = 4;
+struct Fehlberg : ExplicitRungeKutta<FehlbergTableau> {
+  // Order of the continuous extension
+  static constexpr int kDenseOrder = 4;
+
+  /**
+   * The continuous extension of a step of Fehlberg's method.
+   *
+   * x(t0 + th*h) = x0 + h sum b_i(th) k_i, where k_1..k_6 are
+   * the derivatives at the stages of the step
+   * and k_7 = f(t0 + h, x1) is the derivative at its end.
+   * The quartic weights b_i satisfy the order conditions up to order 4
+   * for every th, give the fifth order solution at th = 1,
+   * and match the derivatives at both ends of the step.
+   */
+  template <int N>
+  struct Interpolant {
+    inline Vectord<N> operator()(double t) const {
+      double th = (t - t0)/h;
+      double b1 = th*(1 + th*(-71/30.0 + th*(298/135.0 - th*13/18.0)));
+      double b3 = th*th*(1664/475.0 + th*(-3328/675.0 + th*1664/855.0));
+      double b4 = th*th*(-15379/3135.0 + th*(17576/1485.0
+          - th*2197/342.0));
+      double b5 = th*th*(54/25.0 + th*(-126/25.0 + th*27/10.0));
+      double b6 = th*th*(6/55.0 - th*4/55.0);
+      double b7 = th*th*(3/2.0 + th*(-4 + th*5/2.0));
+      return x0 + h*(b1*k[0] + b3*k[2] + b4*k[3] + b5*k[4] + b6*k[5]
+          + b7*k[6]);
+    }
+
+    double t0;
+    double h;
+    Vectord<N> x0;
+    Vectord<N> k[7];
+  };
 
+  /**
+   * Returns the continuous extension of the step of size h from (t, x),
+   * given the derivatives dv at its start and dv1 at its end.
+   */
   template <IvpDerivative D>
-  inline std::pair<Vectord<D::kDim>, double> step(D f, double t,
-      const Vectord<D::kDim>& x, double& h, double tolerance) const {
-    Vectord<D::kDim> k[6];
-    k[0] = h*f(t, x);
-    k[1] = h*f(t +   1/4.0*h, x + 1/4.0*k[0]);
-    k[2] = h*f(t +   3/8.0*h, x + (3*k[0] + 9*k[1])/32);
-    k[3] = h*f(t + 12/13.0*h, x + (1932*k[0] - 7200*k[1] + 7296*k[2])/2197);
-    k[4] = h*f(t +         h, x + 439/216.0*k[0] - 8*k[1] + 3680/513.0*k[2]
-                                - 845/4104.0*k[3]);
-    k[5] = h*f(t +   1/2.0*h, x - 8/27.0*k[0] + 2*k[1] - 3544/2565.0*k[2]
-                                + 1859/4104.0*k[3] - 11/40.0*k[4]);
-
-    Vectord<D::kDim> rk4 = x + 25/216.0*k[0] + 1408/2565.0*k[2]
-                          + 2197/4104.0*k[3] - 1/5.0*k[4];
-    Vectord<D::kDim> rk5 = x + 16/135.0*k[0] + 6656/12825.0*k[2]
-                        + 28561/56430.0*k[3] - 9/50.0*k[4] + 2/55.0*k[5];
-    double error = (rk5 - rk4).norm();
-    double q = std::pow(tolerance * h / (2*error), 0.25);
-    q = std::max(0.1, std::min(q, 4.0));
-    h *= q;
-    return {rk5, error};
+  inline Interpolant<D::kDim> interpolant(D f, double t,
+      const Vectord<D::kDim>& x, const Vectord<D::kDim>& dv, double h,
+      const Vectord<D::kDim>& dv1) const {
+    Interpolant<D::kDim> in{t, h, x};
+    stages(f, t, x, h, dv, in.k);
+    in.k[6] = dv1;
+    return in;
   }
 };
 
@@ -0,0 +1,29 @@
+#ifndef INCLUDE_METHODS_INTERFACES_DENSE_OUTPUT_METHOD_HPP_
+#define INCLUDE_METHODS_INTERFACES_DENSE_OUTPUT_METHOD_HPP_
+
+#include <concepts>
+#include "initial_value_problem.hpp"
+#include "problems/taylor1.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * DenseOutputMethod
+ * A single-step method with a continuous extension.
+ *
+ * Given a step of size h from (t, x) with derivatives dv at its start
+ * and dv1 at its end, interpolant returns a callable that approximates
+ * the solution at any time inside the step without allocating.
+ */
+template <typename Method, typename Dv = Taylor1::Dv>
+concept DenseOutputMethod = requires(Method met, Dv f, double t,
+    const Vectord<Dv::kDim>& x, double h, const Vectord<Dv::kDim>& dv) {
+  { Method::kDenseOrder } -> std::same_as<const int&>;
+  { met.interpolant(f, t, x, dv, h, dv)(t) }
+      -> std::same_as<Vectord<Dv::kDim>>;
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_INTERFACES_DENSE_OUTPUT_METHOD_HPP_
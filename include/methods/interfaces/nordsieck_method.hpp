@@ -0,0 +1,48 @@
+#ifndef INCLUDE_METHODS_INTERFACES_NORDSIECK_METHOD_HPP_
+#define INCLUDE_METHODS_INTERFACES_NORDSIECK_METHOD_HPP_
+
+#include <concepts>
+#include "problems/arenstorf.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * NordsieckMethod
+ * A variable order multistep method that keeps its history
+ * in Nordsieck form, z[j] = h^j P^(j)(t)/j! for j = 0..q,
+ * where P is a polynomial of degree q that fits the last q+1 points,
+ * or the last point and the derivatives at the last q points
+ * if kDerivativeNodes, so that changing the step size only rescales z.
+ *
+ * A step predicts z by Taylor expansion and corrects it
+ * with z[j] += l[j]*e, where l = corrector(q, xi) and the Corrector
+ * solves the equation of the method for e.
+ * xi[i] is the distance from the last point to the i-th previous one
+ * in units of h. Raising the order adds c*raiser(q, xi) to z,
+ * with c chosen to fit the next older point (or derivative),
+ * and lowering it subtracts z[q]*lowerer(q, xi), both keeping
+ * the other conditions.
+ * The local error of order q is errorCoefficient(q, xi) times |e|,
+ * and errorConstant[q] times h^(q+1) x^(q+1) with constant steps.
+ * A Corrector<N> keeps what it reuses between steps.
+ */
+template <typename Method, typename Dv = Arenstorf::Dv>
+concept NordsieckMethod = requires(Method met, Dv f, double t,
+    const Vectord<Dv::kDim>* z, double h, int q, const double* xi,
+    const typename Method::Coefficients& l, Vectord<Dv::kDim>& e,
+    double tol, typename Method::template Corrector<Dv::kDim> corrector) {
+  { Method::kMaxOrder } -> std::same_as<const int&>;
+  { Method::kDerivativeNodes } -> std::same_as<const bool&>;
+  { Method::corrector(q, xi) } -> std::same_as<typename Method::Coefficients>;
+  { Method::raiser(q, xi) } -> std::same_as<typename Method::Coefficients>;
+  { Method::lowerer(q, xi) } -> std::same_as<typename Method::Coefficients>;
+  { Method::errorCoefficient(q, xi) } -> std::convertible_to<double>;
+  { Method::errorConstant[Method::kMaxOrder] }
+      -> std::convertible_to<double>;
+  { corrector.correct(f, t, z, h, q, l, e, tol) } -> std::same_as<bool>;
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_INTERFACES_NORDSIECK_METHOD_HPP_
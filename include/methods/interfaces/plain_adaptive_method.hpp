@@ -23,6 +23,39 @@ concept PlainAdaptiveMethod = requires(Method met, Dv f, double t,
   //     -> std::same_as<Vectord<Dv::kDim>, double>;
 };
 
+/**
+ * FsalAdaptiveMethod
+ * A PlainAdaptiveMethod whose last evaluation is the derivative
+ * at the new point ("first same as last").
+ * Its hinted_step takes the derivative dv at (t, x) and writes into dv1
+ * the one at the new point, which is the hint of the next step.
+ */
+template <typename Method, typename Dv = Arenstorf::Dv>
+concept FsalAdaptiveMethod = PlainAdaptiveMethod<Method, Dv>
+    && requires(Method met, Dv f, double t, const Vectord<Dv::kDim>& x,
+        double& h, double tol, const Vectord<Dv::kDim>& dv,
+        Vectord<Dv::kDim>& dv1) {
+  { met.hinted_step(f, t, x, h, tol, dv, dv1) }
+      -> std::same_as<std::pair<Vectord<Dv::kDim>, double>>;
+};
+
+/**
+ * CachingAdaptiveMethod
+ * A PlainAdaptiveMethod that reuses work between the steps of a solve,
+ * such as the Jacobian of an implicit method, keeping it in a Cache<N>.
+ * Its cached_step takes the cache besides the arguments of step,
+ * and the solvers tell the cache when the step is accepted.
+ */
+template <typename Method, typename Dv = Arenstorf::Dv>
+concept CachingAdaptiveMethod = PlainAdaptiveMethod<Method, Dv>
+    && requires(Method met, Dv f, double t, const Vectord<Dv::kDim>& x,
+        double& h, double tol,
+        typename Method::template Cache<Dv::kDim>& cache) {
+  { met.cached_step(f, t, x, h, tol, cache) }
+      -> std::same_as<std::pair<Vectord<Dv::kDim>, double>>;
+  cache.accept();
+};
+
 }  // namespace odelib
 
 #endif  // INCLUDE_METHODS_INTERFACES_PLAIN_ADAPTIVE_METHOD_HPP_
@@ -21,6 +21,18 @@ concept PlainMethod = std::default_initializable<Method> && requires(Method met,
   { met.hinted_step(f, t, x, h, dv) } -> std::same_as<Vectord<Dv::kDim>>;
 };
 
+/**
+ * InPlaceMethod
+ * A PlainMethod that can also overwrite the point with the result
+ * of the step, using another vector of the size of the problem
+ * as work space, so that a step needs no more memory than those two.
+ */
+template <typename Method, typename Dv = Taylor1::Dv>
+concept InPlaceMethod = PlainMethod<Method, Dv> && requires(Method met,
+    Dv f, double t, Vectord<Dv::kDim>& x, double h, Vectord<Dv::kDim>& work) {
+  { met.advance(f, t, x, h, work) } -> std::same_as<void>;
+};
+
 }  // namespace odelib
 
 #endif  // INCLUDE_METHODS_INTERFACES_PLAIN_METHOD_HPP_
@@ -0,0 +1,92 @@
+#ifndef INCLUDE_METHODS_LOW_STORAGE_RUNGE_KUTTA_HPP_
+#define INCLUDE_METHODS_LOW_STORAGE_RUNGE_KUTTA_HPP_
+
+#include <concepts>
+#include "initial_value_problem.hpp"
+#include "tools/unroll.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * LowStorageTableau
+ * The coefficients of an explicit Runge-Kutta method of kStages stages
+ * in Williamson's 2N form, given as constexpr class variables.
+ * Starting with dx = 0, each stage i does
+ *
+ *   dx = A[i] dx + h f(t + c[i] h, x)
+ *   x = x + B[i] dx
+ *
+ * so only x and dx are kept between stages. A[0] must be 0.
+ */
+template <typename T>
+concept LowStorageTableau = requires {
+  { T::kOrder } -> std::same_as<const int&>;
+  { T::kStages } -> std::same_as<const int&>;
+  { T::A[T::kStages-1] } -> std::convertible_to<double>;
+  { T::B[T::kStages-1] } -> std::convertible_to<double>;
+  { T::c[T::kStages-1] } -> std::convertible_to<double>;
+};
+
+/**
+ * Low Storage Runge-Kutta Method
+ * A method defined by a LowStorageTableau.
+ *
+ * Besides the step of a PlainMethod, it can advance the point in place
+ * with a work vector of the size of the problem. See InPlaceMethod.
+ * The stages are unrolled at compile time, like in ExplicitRungeKutta.
+ */
+template <LowStorageTableau T>
+struct LowStorageRungeKutta {
+  static constexpr int kOrder = T::kOrder;
+  static constexpr int kStages = T::kStages;
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
+      double h) const {
+    return hinted_step(f, t, x, h, f(t, x));
+  }
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
+      double h, const Vectord<D::kDim>& dv) const {
+    Vectord<D::kDim> y = x;
+    Vectord<D::kDim> dx = h*dv;
+    stages(f, t, y, h, dx);
+    return y;
+  }
+
+  /**
+   * Advances x by a step of size h from t in place.
+   * dx is only used as work space.
+   */
+  template <IvpDerivative D>
+  inline void advance(D f, double t, Vectord<D::kDim>& x, double h,
+      Vectord<D::kDim>& dx) const {
+    dx.noalias() = h*f(t, x);
+    stages(f, t, x, h, dx);
+  }
+
+ protected:
+  /**
+   * Completes the step from the first stage, dx = h f(t, x).
+   */
+  template <IvpDerivative D>
+  inline void stages(D f, double t, Vectord<D::kDim>& x, double h,
+      Vectord<D::kDim>& dx) const {
+    x += T::B[0]*dx;
+    Unroll<kStages-1>([&](auto i1) {
+      constexpr int i = i1 + 1;
+      if constexpr (T::A[i] != 0) {
+        dx = T::A[i]*dx + h*f(t + T::c[i]*h, x);
+      } else {
+        dx.noalias() = h*f(t + T::c[i]*h, x);
+      }
+      x += T::B[i]*dx;
+    });
+  }
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_LOW_STORAGE_RUNGE_KUTTA_HPP_
@@ -1,33 +1,34 @@
 #ifndef INCLUDE_METHODS_MOD_EULER_HPP_
 #define INCLUDE_METHODS_MOD_EULER_HPP_
 
-#include "initial_value_problem.hpp"
-#include "types.hpp"
+#include "methods/explicit_runge_kutta.hpp"
 
 namespace odelib {
 
+/**
+ * Tableau of the Modified Euler's Method.
+ *
+ *  0 ┃
+ *  1 ┃  1
+ * ━━━╋━━━━━━━━━
+ *    ┃ 1/2 1/2
+ */
+struct ModEulerTableau {
+  static constexpr int kOrder = 2;
+  static constexpr int kStages = 2;
+  static constexpr double c[] = {0, 1};
+  static constexpr double a[2][2] = {{}, {1}};
+  static constexpr double b[] = {1/2.0, 1/2.0};
+};
+
 /**
  * Modified's Euler Method (also known as Heun's Method)
  * A fixed step explicit method.
  * It is a Runge-Kutta Method of order 2.
  * 
- * x_{n+1} = x_n + h/2*(f(t_n, x_n) + f(t_n + h/2, x_n + h/2*f(t_n, x_n))
+ * x_{n+1} = x_n + h/2*(f(t_n, x_n) + f(t_n + h, x_n + h*f(t_n, x_n))
  */
-struct ModEuler {
-  static constexpr int kOrder = 2;
-
-  template <IvpDerivative D>
-  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
-      double h) const {
-    return hinted_step(f, t, x, h, f(t, x));
-  }
-
-  template <IvpDerivative D>
-  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
-      double h, const Vectord<D::kDim>& dv) const {
-    return x + (dv*h + f(t+h, x+dv*h)*h)/2;
-  }
-};
+using ModEuler = ExplicitRungeKutta<ModEulerTableau>;
 
 }  // namespace odelib
 
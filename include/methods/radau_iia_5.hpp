@@ -0,0 +1,298 @@
+#ifndef INCLUDE_METHODS_RADAU_IIA_5_HPP_
+#define INCLUDE_METHODS_RADAU_IIA_5_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <utility>
+#include "Eigen/LU"
+#include "initial_value_problem.hpp"
+#include "tools/jacobian.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Radau IIA 5 Method
+ * The fully implicit Runge-Kutta method of order 5 with 3 stages
+ * at the Radau points c = (4 - sqrt(6))/10, (4 + sqrt(6))/10 and 1,
+ * as in Hairer and Wanner's RADAU5.
+ *
+ * It is L-stable and stiffly accurate, suited for very stiff problems
+ * at high accuracy. The stage increments z solve z = h (A ⊗ I) F(x + z),
+ * which is transformed with T^-1 A^-1 T = diag(γ, [α -β; β α])
+ * so that each iteration of the simplified Newton method solves
+ * one real and one complex system of the dimension of the problem,
+ * instead of one three times as large. The Jacobian is reused
+ * between steps while the iteration converges fast,
+ * and the iteration starts from the collocation polynomial
+ * of the last step. See CachingAdaptiveMethod.
+ * The decompositions depend on the step size, so they are only redone
+ * when it changes, and the step is kept while it would grow by less
+ * than kHoldStepRatio, as in RADAU5.
+ *
+ * The error is estimated as in RADAU5, with an embedded formula
+ * of order 3 filtered by (I - h J/γ)^-1 so that it stays bounded
+ * on the stiff components.
+ */
+struct RadauIIA5 {
+  static constexpr int kOrder = 5;
+  static constexpr int kErrorOrder = 3;
+  /**
+   * The step size is kept, with its decompositions,
+   * when the next one would be at most this many times larger.
+   */
+  static constexpr double kHoldStepRatio = 1.2;
+
+  using ComplexMatrix = Eigen::Matrix<std::complex<double>, Eigen::Dynamic,
+      Eigen::Dynamic>;
+
+  /**
+   * What is reused between steps: the Jacobian, the decompositions
+   * for the last step size, the rate of convergence of the iteration
+   * and the stage increments of the last accepted step.
+   */
+  template <int N>
+  class Cache {
+   public:
+    inline void accept() {
+      rejected_ = false;
+      // Newton's divided differences of the collocation polynomial
+      // in units of the step from the new point, through 0 at 0,
+      // z[i] - z[2] at c[i] - 1 and -z[2] at -1
+      Vectord<N> d1 = (z_[0] - z_[1])/(kC[0] - kC[1]);
+      Vectord<N> d2 = (d1 - z_[0]/kC[0])/kC[1];
+      r_[0] = (z_[1] - z_[2])/(kC[1] - 1);
+      r_[1] = (d1 - r_[0])/(kC[0] - 1);
+      r_[2] = r_[1] - d2;
+      hOld_ = h_;
+    }
+
+   private:
+    friend struct RadauIIA5;
+
+    Matrixd<N, N> jac_;
+    Eigen::PartialPivLU<Matrixd<N, N>> real_;
+    // Allocated once, since it is twice as large as a real one
+    // and would not fit in the stack for the larger problems
+    Eigen::PartialPivLU<ComplexMatrix> complex_;
+    // Step of the decompositions, 0 if they are outdated
+    double hLu_ = 0;
+    bool stale_ = true;
+    bool fresh_ = false;
+    bool rejected_ = true;
+    double faccon_ = 1;
+    // The stage increments of the last step and its size
+    Vectord<N> z_[3];
+    double h_ = 0;
+    // The collocation polynomial of the last accepted step, if hOld_ > 0
+    Vectord<N> r_[3];
+    double hOld_ = 0;
+  };
+
+  /**
+   * A step without reusing anything from the previous ones.
+   */
+  template <IvpDerivative D>
+  inline std::pair<Vectord<D::kDim>, double> step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance) const {
+    Cache<D::kDim> cache;
+    return cached_step(f, t, x, h, tolerance, cache);
+  }
+
+  /**
+   * Solves the stages by simplified Newton iteration,
+   * with a new Jacobian if the one of the cache is stale
+   * or the iteration fails with it. If it fails with a new one,
+   * the step is rejected with an infinite error.
+   * Then the step size is multiplied by
+   * (tolerance*h/(2*error))^(1/kErrorOrder), within [0.1, 4],
+   * unless that is in [1, kHoldStepRatio].
+   */
+  template <IvpDerivative D>
+  std::pair<Vectord<D::kDim>, double> cached_step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance,
+      Cache<D::kDim>& cache) const {
+    constexpr int N = D::kDim;
+    Vectord<N> dv = f(t, x);
+    cache.fresh_ = false;
+    if (cache.stale_) {
+      jacobian(f, t, x, dv, cache);
+    }
+    Vectord<N>* z = cache.z_;
+    while (true) {
+      if (cache.hLu_ != h) {
+        decompose(h, cache);
+      }
+      predict(h, x, cache);
+      if (solve(f, t, x, h, tolerance, cache)) {
+        break;
+      }
+      if (cache.fresh_) {
+        cache.rejected_ = true;
+        h *= 0.5;
+        return {x, std::numeric_limits<double>::infinity()};
+      }
+      jacobian(f, t, x, dv, cache);
+    }
+    cache.h_ = h;
+
+    Vectord<N> filtered = (kE[0]*z[0] + kE[1]*z[1] + kE[2]*z[2])/h;
+    Vectord<N> e = cache.real_.solve(dv + filtered);
+    double error = e.norm();
+    // Hairer and Wanner's second estimate, which is smaller
+    // on very stiff problems, for the first step and after rejections
+    if (error >= h*tolerance && cache.rejected_) {
+      e = cache.real_.solve(f(t, x + e) + filtered);
+      error = e.norm();
+    }
+    if (error >= h*tolerance) {
+      cache.rejected_ = true;
+      cache.stale_ = !cache.fresh_;
+    }
+    double q = std::pow(tolerance * h / (2*error), 1.0/kErrorOrder);
+    q = std::max(0.1, std::min(q, 4.0));
+    if (q < 1 || q > kHoldStepRatio) {
+      h *= q;
+    }
+    return {x + z[2], error};
+  }
+
+ private:
+  static constexpr double kSqrt6 = 2.449489742783178;
+  static constexpr double kC[] = {(4 - kSqrt6)/10, (4 + kSqrt6)/10, 1};
+  // The eigenvalues of A^-1, γ and α ± iβ
+  static constexpr double kGamma = 3.637834252744496;
+  static constexpr double kAlpha = 2.681082873627752;
+  static constexpr double kBeta = 3.050430199247411;
+  // The eigenvectors T and T^-1
+  static constexpr double kT[3][3] = {
+    {9.1232394870892942792e-2, -0.14125529502095420843,
+     -3.0029194105147424492e-2},
+    {0.24171793270710701896, 0.20412935229379993199,
+     0.38294211275726193779},
+    {0.96604818261509293619, 1, 0},
+  };
+  static constexpr double kTInv[3][3] = {
+    {4.3255798900631553510, 0.33919925181580986954, 0.54177053993587487119},
+    {-4.1787185915519047273, -0.32768282076106238708,
+     0.47662355450055045196},
+    {-0.50287263494578687595, 2.5719269498556054292,
+     -0.59603920482822492497},
+  };
+  // The coefficients of the error estimate, times γ
+  static constexpr double kE[] = {
+    -(13 + 7*kSqrt6)/3, (-13 + 7*kSqrt6)/3, -1/3.0
+  };
+  static constexpr int kMaxIterations = 7;
+  // Fraction of the tolerance for the iteration
+  static constexpr double kNewtonTol = 0.03;
+  // The Jacobian is kept while the iteration converges faster than this
+  static constexpr double kReuseRate = 0.1;
+
+  template <IvpDerivative D>
+  static inline void jacobian(const D& f, double t, const Vectord<D::kDim>& x,
+      const Vectord<D::kDim>& dv, Cache<D::kDim>& cache) {
+    cache.jac_ = Jacobian(f, t, x, dv);
+    cache.stale_ = false;
+    cache.fresh_ = true;
+    cache.hLu_ = 0;
+  }
+
+  template <int N>
+  static inline void decompose(double h, Cache<N>& cache) {
+    using Complex = std::complex<double>;
+    int n = cache.jac_.rows();
+    cache.real_.compute(Matrixd<N, N>::Identity(n, n)*(kGamma/h)
+        - cache.jac_);
+    cache.complex_.compute(ComplexMatrix::Identity(n, n)*Complex(kAlpha/h,
+        kBeta/h) - cache.jac_.template cast<Complex>());
+    cache.hLu_ = h;
+  }
+
+  /**
+   * Starts the stage increments from the collocation polynomial
+   * of the last accepted step, or from zero.
+   */
+  template <int N>
+  static inline void predict(double h, const Vectord<N>& x, Cache<N>& cache) {
+    for (int i = 0; i < 3; ++i) {
+      if (cache.hOld_ > 0) {
+        double s = kC[i]*h/cache.hOld_;
+        cache.z_[i] = s*(cache.r_[0] + (s - kC[1] + 1)*(cache.r_[1]
+            + (s - kC[0] + 1)*cache.r_[2]));
+      } else {
+        cache.z_[i] = Vectord<N>::Zero(x.size());
+      }
+    }
+  }
+
+  /**
+   * The simplified Newton iteration on the transformed increments
+   * w = T^-1 z, while the corrections shrink fast enough
+   * to fall below a fraction of the tolerance
+   * in at most kMaxIterations iterations.
+   */
+  template <IvpDerivative D>
+  static bool solve(const D& f, double t, const Vectord<D::kDim>& x, double h,
+      double tol, Cache<D::kDim>& cache) {
+    using Complex = std::complex<double>;
+    constexpr int N = D::kDim;
+    Vectord<N>* z = cache.z_;
+    Vectord<N> w[3];
+    Vectord<N> fz[3];
+    transform(kTInv, z, w);
+    double bound = kNewtonTol*h*tol;
+    double faccon = std::pow(std::max(cache.faccon_,
+        std::numeric_limits<double>::epsilon()), 0.8);
+    double theta = 1;
+    double del1 = 0;
+    for (int m = 0; m < kMaxIterations; ++m) {
+      for (int i = 0; i < 3; ++i) {
+        z[i] = f(t + kC[i]*h, x + z[i]);
+      }
+      transform(kTInv, z, fz);
+      Vectord<N> d0 = cache.real_.solve(fz[0] - (kGamma/h)*w[0]);
+      Eigen::Matrix<Complex, N, 1> rhs(x.size());
+      rhs.real() = fz[1] - (kAlpha/h)*w[1] + (kBeta/h)*w[2];
+      rhs.imag() = fz[2] - (kAlpha/h)*w[2] - (kBeta/h)*w[1];
+      Eigen::Matrix<Complex, N, 1> d12 = cache.complex_.solve(rhs);
+      w[0] += d0;
+      w[1] += d12.real();
+      w[2] += d12.imag();
+      double del = std::sqrt(d0.squaredNorm() + d12.squaredNorm());
+      if (m > 0) {
+        theta = del/del1;
+        if (theta >= 0.99) {
+          break;
+        }
+        faccon = theta/(1 - theta);
+      }
+      transform(kT, w, z);
+      if (faccon*del <= bound) {
+        cache.faccon_ = faccon;
+        cache.stale_ = m > 0 && theta > kReuseRate;
+        return true;
+      }
+      del1 = del;
+    }
+    cache.faccon_ = 1;
+    return false;
+  }
+
+  /**
+   * Computes y = M x for the 3 vectors of x.
+   */
+  template <int N>
+  static inline void transform(const double (&m)[3][3], const Vectord<N>* x,
+      Vectord<N>* y) {
+    for (int i = 0; i < 3; ++i) {
+      y[i] = m[i][0]*x[0] + m[i][1]*x[1] + m[i][2]*x[2];
+    }
+  }
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_RADAU_IIA_5_HPP_
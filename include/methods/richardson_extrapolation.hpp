@@ -28,6 +28,8 @@ namespace odelib {
 template <PlainMethod Method>
 struct RichardsonExtrapolation {
   static constexpr int kOrder = Method::kOrder+1;
+  // The error is estimated for the steps of the base method
+  static constexpr int kErrorOrder = Method::kOrder;
 
   Method met;
 
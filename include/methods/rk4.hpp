@@ -2,33 +2,74 @@
 #define INCLUDE_METHODS_RK4_HPP_
 
 #include "initial_value_problem.hpp"
+#include "methods/explicit_runge_kutta.hpp"
 #include "types.hpp"
 
 namespace odelib {
 
+/**
+ * Tableau of the classic Runge-Kutta Method.
+ *
+ *  0  ┃
+ * 1/2 ┃ 1/2
+ * 1/2 ┃  0  1/2
+ *  1  ┃  0   0   1
+ * ━━━━╋━━━━━━━━━━━━━━━━━
+ *     ┃ 1/6 1/3 1/3 1/6
+ */
+struct RK4Tableau {
+  static constexpr int kOrder = 4;
+  static constexpr int kStages = 4;
+  static constexpr double c[] = {0, 1/2.0, 1/2.0, 1};
+  static constexpr double a[4][4] = {{}, {1/2.0}, {0, 1/2.0}, {0, 0, 1}};
+  static constexpr double b[] = {1/6.0, 1/3.0, 1/3.0, 1/6.0};
+};
+
 /**
  * Classic fourth order Runge-Kutta Method
  * 
  * Computes a fourth order approximation using 4 evaluations.
  */
-struct RK4 {
-  static constexpr int kOrder = 4;
+struct RK4 : ExplicitRungeKutta<RK4Tableau> {
+  // Order of the continuous extension.
+  // No interpolant of the four stages of RK4 has order 4.
+  static constexpr int kDenseOrder = 3;
 
-  template <IvpDerivative D>
-  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
-      double h) const {
-    return hinted_step(f, t, x, h, f(t, x));
-  }
+  /**
+   * The continuous extension of a step of RK4.
+   *
+   * x(t0 + th*h) = x0 + h sum b_i(th) k_i, where k_i are the derivatives
+   * at the stages of the step, with
+   * b_1 = th - 3/2 th^2 + 2/3 th^3, b_2 = b_3 = th^2 - 2/3 th^3
+   * and b_4 = -1/2 th^2 + 2/3 th^3.
+   */
+  template <int N>
+  struct Interpolant {
+    inline Vectord<N> operator()(double t) const {
+      double th = (t - t0)/h;
+      double b1 = th*(1 + th*(-3/2.0 + th*2/3.0));
+      double b23 = th*th*(1 - th*2/3.0);
+      double b4 = th*th*(-1/2.0 + th*2/3.0);
+      return x0 + h*(b1*k[0] + b23*(k[1] + k[2]) + b4*k[3]);
+    }
+
+    double t0;
+    double h;
+    Vectord<N> x0;
+    Vectord<N> k[4];
+  };
 
+  /**
+   * Returns the continuous extension of the step of size h from (t, x).
+   * The derivative at the end of the step, dv1, is not needed.
+   */
   template <IvpDerivative D>
-  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
-      double h, const Vectord<D::kDim>& d) const {
-    Vectord<D::kDim> k[4];
-    k[0] = d*h;
-    k[1] = f(t+h/2, x + k[0]/2)*h;
-    k[2] = f(t+h/2, x + k[1]/2)*h;
-    k[3] = f(t+h, x + k[2])*h;
-    return x + (k[0] + 2*k[1] + 2*k[2] + k[3])/6;
+  inline Interpolant<D::kDim> interpolant(D f, double t,
+      const Vectord<D::kDim>& x, const Vectord<D::kDim>& d, double h,
+      const Vectord<D::kDim>& dv1) const {
+    Interpolant<D::kDim> in{t, h, x};
+    stages(f, t, x, h, d, in.k);
+    return in;
   }
 };
 
@@ -0,0 +1,72 @@
+#ifndef INCLUDE_METHODS_RODAS4_HPP_
+#define INCLUDE_METHODS_RODAS4_HPP_
+
+#include "methods/rosenbrock.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of Hairer and Wanner's RODAS (1996), with gamma = 1/4.
+ * m gives the fourth order solution and mHat the third order one.
+ * The last two stages are at the new point and both solutions
+ * are stages of the method, so it is stiffly accurate.
+ * d gives the third order continuous extension of their code.
+ */
+struct Rodas4Tableau {
+  static constexpr int kOrder = 3;
+  static constexpr int kStages = 6;
+  static constexpr int kDenseOrder = 3;
+  static constexpr double gamma = 0.25;
+  static constexpr double alpha[] = {0, 0.386, 0.21, 0.63, 1, 1};
+  static constexpr double gammaSum[] = {
+    0.25, -0.1043, 0.1035, -0.0362, 0, 0
+  };
+  static constexpr double a[6][6] = {
+    {},
+    {1.544},
+    {0.9466785280815826, 0.2557011698983284},
+    {3.314825187068521, 2.896124015972201, 0.9986419139977817},
+    {1.221224509226641, 6.019134481288629, 12.53708332932087,
+     -0.6878860361058950},
+    {1.221224509226641, 6.019134481288629, 12.53708332932087,
+     -0.6878860361058950, 1},
+  };
+  static constexpr double c[6][6] = {
+    {},
+    {-5.6688},
+    {-2.430093356833875, -0.2063599157091915},
+    {-0.1073529058151375, -9.594562251023355, -20.47028614809616},
+    {7.496443313967647, -10.24680431464352, -33.99990352819905,
+     11.70890893206160},
+    {8.083246795921522, -7.981132988064893, -31.52159432874371,
+     16.31930543123136, -6.058818238834054},
+  };
+  static constexpr double m[] = {
+    1.221224509226641, 6.019134481288629, 12.53708332932087,
+    -0.6878860361058950, 1, 1
+  };
+  static constexpr double mHat[] = {
+    1.221224509226641, 6.019134481288629, 12.53708332932087,
+    -0.6878860361058950, 1, 0
+  };
+  static constexpr double d[2][6] = {
+    {10.12623508344586, -7.487995877610167, -34.80091861555747,
+     -7.992771707568823, 1.025137723295662, 0},
+    {-0.6762803392801253, 6.087714651680015, 16.43084320892478,
+     24.76722511418386, -6.594389125716872, 0},
+  };
+};
+
+/**
+ * RODAS4
+ * An adaptive Rosenbrock method of order 4
+ *
+ * L-stable and stiffly accurate, so it damps the fast components
+ * of very stiff problems, as Robertson's, instead of carrying them.
+ * It evaluates the derivative 6 times per step.
+ */
+using Rodas4 = Rosenbrock<Rodas4Tableau>;
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_RODAS4_HPP_
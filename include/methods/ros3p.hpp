@@ -0,0 +1,51 @@
+#ifndef INCLUDE_METHODS_ROS3P_HPP_
+#define INCLUDE_METHODS_ROS3P_HPP_
+
+#include "methods/rosenbrock.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of Lang and Verwer's ROS3P (2001), with gamma = 1/2 + sqrt(3)/6.
+ * m gives the third order solution and mHat the second order one.
+ */
+struct Ros3pTableau {
+  static constexpr int kOrder = 2;
+  static constexpr int kStages = 3;
+  static constexpr double gamma = 7.886751345948129e-1;
+  static constexpr double alpha[] = {0, 1, 1};
+  static constexpr double gammaSum[] = {
+    7.886751345948129e-1, -2.113248654051871e-1, -1.077350269189626
+  };
+  static constexpr double a[3][3] = {
+    {},
+    {1.267949192431123},
+    {1.267949192431123, 0},
+  };
+  static constexpr double c[3][3] = {
+    {},
+    {-1.607695154586736},
+    {-3.464101615137755, -1.732050807568877},
+  };
+  static constexpr double m[] = {
+    2, 5.773502691896258e-1, 4.226497308103742e-1
+  };
+  static constexpr double mHat[] = {
+    2.113248654051871, 1, 4.226497308103742e-1
+  };
+};
+
+/**
+ * ROS3P
+ * An adaptive Rosenbrock method of order 3
+ *
+ * Keeps its third order on the stiff problems that come from
+ * discretizing parabolic equations in space, where other Rosenbrock
+ * methods lose it. It is A-stable but not L-stable.
+ * Its dense output is the cubic Hermite interpolant of the step.
+ */
+using Ros3p = Rosenbrock<Ros3pTableau>;
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_ROS3P_HPP_
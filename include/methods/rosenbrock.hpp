@@ -0,0 +1,307 @@
+#ifndef INCLUDE_METHODS_ROSENBROCK_HPP_
+#define INCLUDE_METHODS_ROSENBROCK_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <utility>
+#include "Eigen/LU"
+#include "initial_value_problem.hpp"
+#include "methods/explicit_runge_kutta.hpp"
+#include "tools/jacobian.hpp"
+#include "tools/unroll.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * RosenbrockTableau
+ * The coefficients of a Rosenbrock method of kStages stages
+ * in the form of Hairer and Wanner, which avoids the products
+ * with the Jacobian J. Each stage solves
+ *
+ *   (I/(h gamma) - J) u_i = f(t + alpha[i] h, x + sum_{j<i} a[i][j] u_j)
+ *                           + sum_{j<i} c[i][j]/h u_j + gammaSum[i] h f_t,
+ *
+ * where f_t is the derivative of f with respect to t,
+ * and the solution is x + sum m[i] u_i. mHat gives the embedded one,
+ * and kOrder is the order of the error estimate, the lower of both.
+ * Only the strictly lower triangles of a and c are used
+ * and alpha[0] must be 0.
+ */
+template <typename T>
+concept RosenbrockTableau = requires {
+  { T::kOrder } -> std::same_as<const int&>;
+  { T::kStages } -> std::same_as<const int&>;
+  { T::gamma } -> std::convertible_to<double>;
+  { T::alpha[T::kStages-1] } -> std::convertible_to<double>;
+  { T::gammaSum[T::kStages-1] } -> std::convertible_to<double>;
+  { T::a[T::kStages-1][T::kStages-1] } -> std::convertible_to<double>;
+  { T::c[T::kStages-1][T::kStages-1] } -> std::convertible_to<double>;
+  { T::m[T::kStages-1] } -> std::convertible_to<double>;
+  { T::mHat[T::kStages-1] } -> std::convertible_to<double>;
+};
+
+/**
+ * DenseRosenbrockTableau
+ * A RosenbrockTableau with a continuous extension of order kDenseOrder,
+ * x(t) = (1 - th) x0 + th (x1 + (1 - th) (r2 + th r3)),
+ * where th = (t - t0)/h, r2 = sum d[0][i] u_i and r3 = sum d[1][i] u_i,
+ * as in Hairer and Wanner's RODAS.
+ */
+template <typename T>
+concept DenseRosenbrockTableau = RosenbrockTableau<T> && requires {
+  { T::kDenseOrder } -> std::same_as<const int&>;
+  { T::d[1][T::kStages-1] } -> std::convertible_to<double>;
+};
+
+/**
+ * Rosenbrock Method
+ * A linearly implicit method defined by a RosenbrockTableau.
+ *
+ * Each step evaluates the Jacobian once, decomposes I/(h gamma) - J once
+ * and solves a linear system per stage, with no Newton iteration,
+ * so its cost per step is fixed even on stiff problems.
+ * The derivatives of f are the ones of the problem if it provides them
+ * (see SpaceDerivableIvpDerivative and TimeDerivableIvpDerivative)
+ * and finite difference approximations otherwise.
+ * It is a CachingAdaptiveMethod, whose cache keeps the stages
+ * of the accepted step for its continuous extension,
+ * and a DenseOutputMethod.
+ */
+template <RosenbrockTableau T>
+struct Rosenbrock {
+  static constexpr int kOrder = T::kOrder;
+  static constexpr int kStages = T::kStages;
+  // Order of the continuous extension of the tableau,
+  // or of the cubic Hermite interpolant if it has none
+  static constexpr int kDenseOrder = [] {
+    if constexpr (DenseRosenbrockTableau<T>) {
+      return T::kDenseOrder;
+    } else {
+      return 3;
+    }
+  }();
+
+  template <int N>
+  using Interpolant = PolynomialInterpolant<N, 3>;
+
+  /**
+   * The error is bounded per step, as in RODAS, see AllowedError.
+   * Bounded per unit step, the low order tableaus take many times
+   * more steps than their accuracy needs at small tolerances.
+   */
+  static constexpr bool kErrorPerStep = true;
+
+  /**
+   * The stages of the last step tried and of the last one accepted,
+   * whose continuous extension is built from them,
+   * and the derivative at the current point, once it is known.
+   */
+  template <int N>
+  class Cache {
+   public:
+    inline void accept() {
+      std::swap(tried_, accepted_);
+      hasDv_ = false;
+    }
+
+   private:
+    friend struct Rosenbrock;
+
+    struct Step {
+      double t = 0;
+      double h = 0;
+      Vectord<N> x;
+      Vectord<N> dv;
+      Vectord<N> y;
+      std::array<Vectord<N>, kStages> u;
+    };
+
+    Step tried_;
+    Step accepted_;
+    Vectord<N> dv_;
+    bool hasDv_ = false;
+  };
+
+  /**
+   * A step without keeping its stages.
+   */
+  template <IvpDerivative D>
+  inline std::pair<Vectord<D::kDim>, double> step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance) const {
+    Cache<D::kDim> cache;
+    return cached_step(f, t, x, h, tolerance, cache);
+  }
+
+  /**
+   * Advances with the weights m and estimates the error with mHat,
+   * keeping the stages in the cache.
+   * Then the step size is multiplied by
+   * (tolerance*(1 + |x|)/(2*error))^(1/(kOrder+1)), within [0.1, 4].
+   */
+  template <IvpDerivative D>
+  std::pair<Vectord<D::kDim>, double> cached_step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance,
+      Cache<D::kDim>& cache) const {
+    if (!cache.hasDv_) {
+      cache.dv_ = f(t, x);
+      cache.hasDv_ = true;
+    }
+    auto& s = cache.tried_;
+    s.t = t;
+    s.h = h;
+    s.x = x;
+    s.dv = cache.dv_;
+    const auto& u = s.u;
+    stages(f, t, x, h, s.dv, s.u.data());
+    Vectord<D::kDim> y = x;
+    Vectord<D::kDim> e = Vectord<D::kDim>::Zero(x.size());
+    Unroll<kStages>([&](auto j) {
+      constexpr double m = T::m[j];
+      constexpr double d = T::m[j] - T::mHat[j];
+      if constexpr (m != 0) {
+        y += m*u[j];
+      }
+      if constexpr (d != 0) {
+        e += d*u[j];
+      }
+    });
+    s.y = y;
+    double error = e.norm();
+    double q = std::pow(tolerance*(1 + x.norm())/(2*error),
+        1.0/(kOrder+1));
+    q = std::max(0.1, std::min(q, 4.0));
+    h *= q;
+    return {y, error};
+  }
+
+  /**
+   * Returns the continuous extension of the last step accepted
+   * with the cache, built from its stages.
+   * The cubic Hermite interpolant of the tableaus without one
+   * evaluates the derivative at the new point,
+   * which the cache keeps for the next step.
+   */
+  template <IvpDerivative D>
+  inline Interpolant<D::kDim> interpolant(D f, Cache<D::kDim>& cache) const {
+    const auto& s = cache.accepted_;
+    if constexpr (!DenseRosenbrockTableau<T>) {
+      if (!cache.hasDv_) {
+        cache.dv_ = f(s.t + s.h, s.y);
+        cache.hasDv_ = true;
+      }
+    }
+    return MakeInterpolant(s.t, s.x, s.dv, s.h, cache.dv_, s.u.data());
+  }
+
+  /**
+   * Returns the continuous extension of the step of size h from (t, x),
+   * given the derivatives dv at its start and dv1 at its end.
+   * The stages are recomputed, so it costs a Jacobian
+   * and a decomposition too: when solving, take the interpolants
+   * from the cache instead (see AdaptiveStepper::interpolant).
+   * dv1 is only used by the cubic Hermite interpolant
+   * of the tableaus without a continuous extension.
+   */
+  template <IvpDerivative D>
+  inline Interpolant<D::kDim> interpolant(D f, double t,
+      const Vectord<D::kDim>& x, const Vectord<D::kDim>& dv, double h,
+      const Vectord<D::kDim>& dv1) const {
+    std::array<Vectord<D::kDim>, kStages> u;
+    stages(f, t, x, h, dv, u.data());
+    return MakeInterpolant(t, x, dv, h, dv1, u.data());
+  }
+
+ protected:
+  /**
+   * The increment of the solution, sum m[i] u_i.
+   */
+  template <int N>
+  static inline Vectord<N> Increment(const Vectord<N>* u) {
+    Vectord<N> dx = Vectord<N>::Zero(u[0].size());
+    Unroll<kStages>([&](auto j) {
+      if constexpr (T::m[j] != 0) {
+        dx += T::m[j]*u[j];
+      }
+    });
+    return dx;
+  }
+
+  /**
+   * The continuous extension of the step of size h from (t, x)
+   * with stages u, given the derivatives dv at its start
+   * and dv1 at its end.
+   */
+  template <int N>
+  static inline Interpolant<N> MakeInterpolant(double t,
+      const Vectord<N>& x, const Vectord<N>& dv, double h,
+      const Vectord<N>& dv1, const Vectord<N>* u) {
+    Vectord<N> dx = Increment(u);
+    Interpolant<N> in{t, h, x};
+    if constexpr (DenseRosenbrockTableau<T>) {
+      Vectord<N> r2 = Vectord<N>::Zero(x.size());
+      Vectord<N> r3 = r2;
+      Unroll<kStages>([&](auto j) {
+        if constexpr (T::d[0][j] != 0) {
+          r2 += T::d[0][j]*u[j];
+        }
+        if constexpr (T::d[1][j] != 0) {
+          r3 += T::d[1][j]*u[j];
+        }
+      });
+      in.r[0] = dx + r2;
+      in.r[1] = r3 - r2;
+      in.r[2] = -r3;
+    } else {
+      in.r[0] = h*dv;
+      in.r[1] = 3*dx - h*(2*dv + dv1);
+      in.r[2] = h*(dv + dv1) - 2*dx;
+    }
+    return in;
+  }
+
+  /**
+   * Computes the stages u[0..kStages-1] of the step of size h from (t, x),
+   * where dv is the derivative at (t, x).
+   */
+  template <IvpDerivative D>
+  static inline void stages(D f, double t, const Vectord<D::kDim>& x,
+      double h, const Vectord<D::kDim>& dv, Vectord<D::kDim>* u) {
+    constexpr int N = D::kDim;
+    Eigen::PartialPivLU<Matrixd<N, N>> lu(
+        Matrixd<N, N>::Identity(x.size(), x.size())/(h*T::gamma)
+        - Jacobian(f, t, x, dv));
+    Vectord<N> ft = h*TimeDerivative(f, t, x, dv);
+    Vectord<N> y(x.size());
+    Vectord<N> rhs(x.size());
+    Unroll<kStages>([&](auto i1) {
+      constexpr int i = i1;
+      if constexpr (i == 0) {
+        rhs = dv;
+      } else {
+        y = x;
+        Unroll<i>([&](auto j) {
+          if constexpr (T::a[i][j] != 0) {
+            y += T::a[i][j]*u[j];
+          }
+        });
+        rhs = f(t + T::alpha[i]*h, y);
+        Unroll<i>([&](auto j) {
+          if constexpr (T::c[i][j] != 0) {
+            rhs += (T::c[i][j]/h)*u[j];
+          }
+        });
+      }
+      if constexpr (T::gammaSum[i] != 0) {
+        rhs += T::gammaSum[i]*ft;
+      }
+      u[i] = lu.solve(rhs);
+    });
+  }
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_ROSENBROCK_HPP_
@@ -0,0 +1,216 @@
+#ifndef INCLUDE_METHODS_ROSENBROCK_23_HPP_
+#define INCLUDE_METHODS_ROSENBROCK_23_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+#include "Eigen/LU"
+#include "initial_value_problem.hpp"
+#include "methods/explicit_runge_kutta.hpp"
+#include "tools/jacobian.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Rosenbrock 2(3) Method
+ * Shampine and Reichelt's method of MATLAB's ode23s
+ *
+ * A second order, L-stable Rosenbrock method, with d = 1/(2 + sqrt(2)),
+ *
+ *   W = I - h d J,                    F0 = f(t, x),
+ *   W k1 = F0 + h d f_t,              F1 = f(t + h/2, x + h/2 k1),
+ *   W (k2 - k1) = F1 - k1,            x1 = x + h k2,
+ *
+ * whose error is estimated with a third order stage at the new point,
+ * F2 = f(t + h, x1) and W k3 = F2 - (6 + sqrt(2))(k2 - F1) - 2(k1 - F0)
+ * + h d f_t, as h/6 (k1 - 2 k2 + k3).
+ * F2 is the derivative at the new point, so the method is FSAL
+ * and each step evaluates f twice, the Jacobian once
+ * and decomposes W once. See FsalAdaptiveMethod.
+ * Its cache keeps that derivative and the stages of the accepted step
+ * for its continuous extension. See CachingAdaptiveMethod.
+ * Suited for the large tolerances of moderately stiff problems.
+ */
+struct Rosenbrock23 {
+  static constexpr int kOrder = 2;
+  // Order of the continuous extension
+  static constexpr int kDenseOrder = 2;
+  // The error is bounded per step, as in ode23s, see AllowedError
+  static constexpr bool kErrorPerStep = true;
+
+  template <int N>
+  using Interpolant = PolynomialInterpolant<N, 2>;
+
+  /**
+   * The stages of the last step tried and of the last one accepted,
+   * whose continuous extension is built from them,
+   * and the derivative at the current point, which is the last
+   * evaluation of the step that reached it.
+   */
+  template <int N>
+  class Cache {
+   public:
+    inline void accept() {
+      std::swap(tried_, accepted_);
+      std::swap(dv_, dv1_);
+    }
+
+   private:
+    friend struct Rosenbrock23;
+
+    struct Step {
+      double t = 0;
+      double h = 0;
+      Vectord<N> x;
+      Vectord<N> k1;
+      Vectord<N> k2;
+    };
+
+    Step tried_;
+    Step accepted_;
+    Vectord<N> dv_;
+    Vectord<N> dv1_;
+    bool hasDv_ = false;
+  };
+
+  template <IvpDerivative D>
+  inline std::pair<Vectord<D::kDim>, double> step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance) const {
+    Vectord<D::kDim> dv1;
+    return hinted_step(f, t, x, h, tolerance, f(t, x), dv1);
+  }
+
+  /**
+   * The step from (t, x), given the derivative dv there.
+   * The derivative at the new point is written into dv1.
+   * Then the step size is multiplied by
+   * (tolerance*(1 + |x|)/(2*error))^(1/(kOrder+1)), within [0.1, 4].
+   */
+  template <IvpDerivative D>
+  inline std::pair<Vectord<D::kDim>, double> hinted_step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance,
+      const Vectord<D::kDim>& dv, Vectord<D::kDim>& dv1) const {
+    Stages<D::kDim> s;
+    return advance(f, t, x, h, tolerance, dv, dv1, s);
+  }
+
+  /**
+   * The step from (t, x), keeping its stages in the cache,
+   * with the derivative at (t, x) that the cache keeps.
+   */
+  template <IvpDerivative D>
+  inline std::pair<Vectord<D::kDim>, double> cached_step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance,
+      Cache<D::kDim>& cache) const {
+    if (!cache.hasDv_) {
+      cache.dv_ = f(t, x);
+      cache.hasDv_ = true;
+    }
+    Stages<D::kDim> s;
+    double step = h;
+    auto result = advance(f, t, x, h, tolerance, cache.dv_, cache.dv1_, s);
+    auto& tried = cache.tried_;
+    tried.t = t;
+    tried.h = step;
+    tried.x = x;
+    tried.k1 = s.k1;
+    tried.k2 = s.k2;
+    return result;
+  }
+
+  /**
+   * Returns the continuous extension of the last step accepted
+   * with the cache, built from its stages,
+   * x(t) = x0 + h (th (1 - th) k1 + th (th - 2d) k2)/(1 - 2d),
+   * with th = (t - t0)/h.
+   */
+  template <IvpDerivative D>
+  inline Interpolant<D::kDim> interpolant(D f,
+      const Cache<D::kDim>& cache) const {
+    const auto& s = cache.accepted_;
+    return MakeInterpolant(s.t, s.x, s.h, s.k1, s.k2);
+  }
+
+  /**
+   * Returns the continuous extension of the step of size h from (t, x),
+   * given the derivatives dv at its start and dv1 at its end.
+   * The stages are recomputed, so it costs a Jacobian
+   * and a decomposition too: when solving, take the interpolants
+   * from the cache instead (see AdaptiveStepper::interpolant).
+   */
+  template <IvpDerivative D>
+  inline Interpolant<D::kDim> interpolant(D f, double t,
+      const Vectord<D::kDim>& x, const Vectord<D::kDim>& dv, double h,
+      const Vectord<D::kDim>& dv1) const {
+    Stages<D::kDim> s;
+    stages(f, t, x, h, dv, s);
+    return MakeInterpolant(t, x, h, s.k1, s.k2);
+  }
+
+ private:
+  static constexpr double kD = 1/(2 + std::numbers::sqrt2);
+  static constexpr double kE32 = 6 + std::numbers::sqrt2;
+
+  template <int N>
+  struct Stages {
+    Eigen::PartialPivLU<Matrixd<N, N>> lu;
+    // h d f_t
+    Vectord<N> ft;
+    Vectord<N> k1;
+    Vectord<N> k2;
+    Vectord<N> f1;
+  };
+
+  /**
+   * The step of size h from (t, x) with stages s, given the derivative
+   * dv at (t, x). The derivative at the new point is written into dv1.
+   */
+  template <IvpDerivative D>
+  static inline std::pair<Vectord<D::kDim>, double> advance(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance,
+      const Vectord<D::kDim>& dv, Vectord<D::kDim>& dv1,
+      Stages<D::kDim>& s) {
+    stages(f, t, x, h, dv, s);
+    Vectord<D::kDim> y = x + h*s.k2;
+    dv1 = f(t + h, y);
+    Vectord<D::kDim> k3 = s.lu.solve(dv1 - kE32*(s.k2 - s.f1)
+        - 2*(s.k1 - dv) + s.ft);
+    double error = h/6*(s.k1 - 2*s.k2 + k3).norm();
+    double q = std::pow(tolerance*(1 + x.norm())/(2*error),
+        1.0/(kOrder+1));
+    q = std::max(0.1, std::min(q, 4.0));
+    h *= q;
+    return {y, error};
+  }
+
+  template <int N>
+  static inline Interpolant<N> MakeInterpolant(double t, const Vectord<N>& x,
+      double h, const Vectord<N>& k1, const Vectord<N>& k2) {
+    Interpolant<N> in{t, h, x};
+    in.r[0] = h/(1 - 2*kD)*(k1 - 2*kD*k2);
+    in.r[1] = h/(1 - 2*kD)*(k2 - k1);
+    return in;
+  }
+
+  /**
+   * Computes the stages of the solution of the step of size h from (t, x),
+   * where dv is the derivative at (t, x).
+   */
+  template <IvpDerivative D>
+  static inline void stages(D f, double t, const Vectord<D::kDim>& x,
+      double h, const Vectord<D::kDim>& dv, Stages<D::kDim>& s) {
+    constexpr int N = D::kDim;
+    s.lu.compute(Matrixd<N, N>::Identity(x.size(), x.size())
+        - (h*kD)*Jacobian(f, t, x, dv));
+    s.ft = (h*kD)*TimeDerivative(f, t, x, dv);
+    s.k1 = s.lu.solve(dv + s.ft);
+    s.f1 = f(t + h/2, x + h/2*s.k1);
+    s.k2 = s.lu.solve(s.f1 - s.k1) + s.k1;
+  }
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_ROSENBROCK_23_HPP_
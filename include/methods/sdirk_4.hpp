@@ -0,0 +1,43 @@
+#ifndef INCLUDE_METHODS_SDIRK_4_HPP_
+#define INCLUDE_METHODS_SDIRK_4_HPP_
+
+#include "methods/diagonally_implicit_runge_kutta.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of Hairer and Wanner's SDIRK4 (1996), with gamma = 1/4.
+ * b gives the fourth order solution and bHat the third order one.
+ * The last row of a is b, so the method is stiffly accurate.
+ */
+struct Sdirk4Tableau {
+  static constexpr int kOrder = 3;
+  static constexpr int kStages = 5;
+  static constexpr double gamma = 1/4.0;
+  static constexpr double a[5][5] = {
+    {1/4.0},
+    {1/2.0, 1/4.0},
+    {17/50.0, -1/25.0, 1/4.0},
+    {371/1360.0, -137/2720.0, 15/544.0, 1/4.0},
+    {25/24.0, -49/48.0, 125/16.0, -85/12.0, 1/4.0},
+  };
+  static constexpr double b[] = {
+    25/24.0, -49/48.0, 125/16.0, -85/12.0, 1/4.0
+  };
+  static constexpr double bHat[] = {
+    59/48.0, -17/96.0, 225/32.0, -85/12.0, 0
+  };
+  static constexpr double c[] = {1/4.0, 3/4.0, 11/20.0, 1/2.0, 1};
+};
+
+/**
+ * SDIRK4
+ * An adaptive diagonally implicit method of order 4
+ *
+ * L-stable, with five implicit stages.
+ */
+using Sdirk4 = DiagonallyImplicitRungeKutta<Sdirk4Tableau>;
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_SDIRK_4_HPP_
@@ -0,0 +1,71 @@
+#ifndef INCLUDE_METHODS_SSPRK104_HPP_
+#define INCLUDE_METHODS_SSPRK104_HPP_
+
+#include "initial_value_problem.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Ten Stage, Fourth Order Strong Stability Preserving Runge-Kutta
+ *
+ * Ketcheson's SSPRK(10,4). Every stage is an Euler step of size h/6
+ * or a convex combination of previous stages, so it keeps the
+ * monotonicity of Euler's method with steps up to 6 times larger,
+ * 0.6 per evaluation against the 0.33 of SSPRK3.
+ * Like the LowStorageRungeKutta methods, it can advance the point
+ * in place with a single work vector. See InPlaceMethod.
+ */
+struct SSPRK104 {
+  static constexpr int kOrder = 4;
+  static constexpr int kStages = 10;
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
+      double h) const {
+    return hinted_step(f, t, x, h, f(t, x));
+  }
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
+      double h, const Vectord<D::kDim>& dv) const {
+    Vectord<D::kDim> y = x + (h/6)*dv;
+    Vectord<D::kDim> work = x;
+    stages(f, t, y, h, work);
+    return y;
+  }
+
+  /**
+   * Advances x by a step of size h from t in place.
+   * work is only used as work space.
+   */
+  template <IvpDerivative D>
+  inline void advance(D f, double t, Vectord<D::kDim>& x, double h,
+      Vectord<D::kDim>& work) const {
+    work = x;
+    x += (h/6)*f(t, x);
+    stages(f, t, x, h, work);
+  }
+
+ private:
+  /**
+   * Completes the step from x0 = work after its first Euler step to x.
+   */
+  template <IvpDerivative D>
+  inline void stages(D f, double t, Vectord<D::kDim>& x, double h,
+      Vectord<D::kDim>& work) const {
+    for (int i = 1; i < 5; ++i) {
+      x += (h/6)*f(t + i*h/6, x);
+    }
+    work = work/25 + (9/25.0)*x;
+    x = 15*work - 5*x;
+    for (int i = 2; i < 6; ++i) {
+      x += (h/6)*f(t + i*h/6, x);
+    }
+    x = work + (3/5.0)*x + (h/10)*f(t + h, x);
+  }
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_SSPRK104_HPP_
@@ -1,15 +1,12 @@
 #ifndef INCLUDE_METHODS_SSPRK3_HPP_
 #define INCLUDE_METHODS_SSPRK3_HPP_
 
-#include "initial_value_problem.hpp"
-#include "types.hpp"
+#include "methods/explicit_runge_kutta.hpp"
 
 namespace odelib {
 
 /**
- * Third Order Strong Stability Preserving Explicit Runge-Kutta
- * 
- * Tableau:
+ * Tableau of the SSPRK3 method.
  * 
  *  0  ┃
  *  1  ┃  1
@@ -17,27 +14,19 @@ namespace odelib {
  * ━━━━╋━━━━━━━━━━━━━
  *     ┃ 1/6 1/6 2/3
  */
-struct SSPRK3 {
+struct SSPRK3Tableau {
   static constexpr int kOrder = 3;
-
-  template <IvpDerivative D>
-  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
-      double h) const {
-    return hinted_step(f, t, x, h, f(t, x));
-  }
-
-  template <IvpDerivative D>
-  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
-      double h, const Vectord<D::kDim>& dv) const {
-    Vectord<D::kDim> k[3];
-    k[0] = h*dv;
-    k[1] = h*f(t + h, x + k[0]);
-    k[2] = h*f(t + h/2, x + k[0]/4 + k[1]/4);
-    return x + (k[0] + k[1] + k[2]*4)/6;
-  }
+  static constexpr int kStages = 3;
+  static constexpr double c[] = {0, 1, 1/2.0};
+  static constexpr double a[3][3] = {{}, {1}, {1/4.0, 1/4.0}};
+  static constexpr double b[] = {1/6.0, 1/6.0, 2/3.0};
 };
 
+/**
+ * Third Order Strong Stability Preserving Explicit Runge-Kutta
+ */
+using SSPRK3 = ExplicitRungeKutta<SSPRK3Tableau>;
+
 }  // namespace odelib
 
 #endif  // INCLUDE_METHODS_SSPRK3_HPP_
-
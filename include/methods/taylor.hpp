@@ -21,35 +21,37 @@ struct Taylor {
   template <NDerivableIvpDerivative D>
   inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
       double h) const {
-    return TaylorsExpansion(f, t, x, h).compute();
+    return hinted_step(f, t, x, h, f(t, x));
   }
 
   template <NDerivableIvpDerivative D>
   inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
       double h, const Vectord<D::kDim>& dv) const {
-    return h*dv + TaylorsExpansion(f, t, x, h).template compute<2>();
+    return x + h*dv + TaylorsExpansion(f, t, x, h).compute();
   }
 
  private:
   // This class is merely an intent of performing
   // a compile time loop.
+  // It computes the terms of the expansion after h*f(t, x),
+  // h^(O+1)/(O+1)! * f.dvn<O>(t, x) for O = 1..Order.
   template <NDerivableIvpDerivative D>
   struct TaylorsExpansion {
     D f;
     Vectord<D::kDim> next = Vectord<D::kDim>::Zero();
     const Vectord<D::kDim>& x;
-    double t, h, coef = 1;
+    double t, h, coef;
 
     TaylorsExpansion(D f, double t, const Vectord<D::kDim>& x, double h)
-      : f(f), x(x), t(t), h(h) {}
+      : f(f), x(x), t(t), h(h), coef(h) {}
 
     template <int O = 1>
     inline Vectord<D::kDim>& compute() {
       if constexpr (O == Order + 1) {
         return next;
       } else {
-        coef *= h/O;
-        next += coef * (f.template dvn<O+1>(t, x));
+        coef *= h/(O+1);
+        next += coef * (f.template dvn<O>(t, x));
         return compute<O+1>();
       }
     }
@@ -0,0 +1,51 @@
+#ifndef INCLUDE_METHODS_TR_BDF2_HPP_
+#define INCLUDE_METHODS_TR_BDF2_HPP_
+
+#include <numbers>
+#include "methods/diagonally_implicit_runge_kutta.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of TR-BDF2 with gamma = 1 - sqrt(2)/2, as an ESDIRK
+ * of 3 stages, and the embedded third order solution
+ * of Hosea and Shampine (1996).
+ * b gives the second order solution and bHat the third order one.
+ *
+ *   0     ┃
+ *   2γ    ┃ γ  γ
+ *   1     ┃ w  w  γ
+ * ━━━━━━━━╋━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *         ┃ w          w           γ
+ *         ┃ (1 - w)/3  (3w + 1)/3  γ/3
+ *
+ * with w = sqrt(2)/4.
+ */
+struct TrBdf2Tableau {
+  static constexpr int kOrder = 2;
+  static constexpr int kStages = 3;
+  static constexpr double gamma = 1 - std::numbers::sqrt2/2;
+  static constexpr double w = std::numbers::sqrt2/4;
+  static constexpr double a[3][3] = {
+    {0},
+    {gamma, gamma},
+    {w, w, gamma},
+  };
+  static constexpr double b[] = {w, w, gamma};
+  static constexpr double bHat[] = {(1 - w)/3, (3*w + 1)/3, gamma/3};
+  static constexpr double c[] = {0, 2*gamma, 1};
+};
+
+/**
+ * TR-BDF2
+ * An adaptive diagonally implicit method of order 2
+ *
+ * A step of the trapezoidal rule to t + 2γh followed by one
+ * of the BDF of order 2 to t + h. Unlike the trapezoidal rule,
+ * it is L-stable, and it solves two implicit stages per step.
+ */
+using TrBdf2 = DiagonallyImplicitRungeKutta<TrBdf2Tableau>;
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_TR_BDF2_HPP_
@@ -0,0 +1,107 @@
+#ifndef INCLUDE_METHODS_VERNER_65_HPP_
+#define INCLUDE_METHODS_VERNER_65_HPP_
+
+#include "initial_value_problem.hpp"
+#include "methods/explicit_runge_kutta.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of Verner's "most efficient" 6(5) pair.
+ * b gives the sixth order solution and bHat the fifth order one.
+ * The last row of a is b, so the last stage is the derivative
+ * at the new point (FSAL).
+ */
+struct Verner65Tableau {
+  static constexpr int kOrder = 5;
+  static constexpr int kStages = 9;
+  static constexpr double c[] = {
+    0, 9/50.0, 1/6.0, 1/4.0, 53/100.0, 3/5.0, 4/5.0, 1, 1
+  };
+  static constexpr double a[9][9] = {
+    {},
+    {9/50.0},
+    {29/324.0, 25/324.0},
+    {1/16.0, 0, 3/16.0},
+    {79129/250000.0, 0, -261237/250000.0, 19663/15625.0},
+    {1336883/4909125.0, 0, -25476/30875.0, 194159/185250.0, 8225/78546.0},
+    {-2459386/14727375.0, 0, 19504/30875.0, 2377474/13615875.0,
+     -6157250/5773131.0, 902/735.0},
+    {2699/7410.0, 0, -252/1235.0, -1393253/3993990.0, 236875/72618.0,
+     -135/49.0, 15/22.0},
+    {11/144.0, 0, 0, 256/693.0, 0, 125/504.0, 125/528.0, 5/72.0},
+  };
+  static constexpr double b[] = {
+    11/144.0, 0, 0, 256/693.0, 0, 125/504.0, 125/528.0, 5/72.0, 0
+  };
+  static constexpr double bHat[] = {
+    28/477.0, 0, 0, 212/441.0, -312500/366177.0, 2125/1764.0, 0, -2105/35532.0,
+    2995/17766.0
+  };
+};
+
+/**
+ * Verner's 6(5) Method
+ * An adaptive Runge-Kutta method of order 6
+ *
+ * Advances with a sixth order solution and estimates the error
+ * with an embedded fifth order one. Like Dormand-Prince 5(4),
+ * its last stage is the first one of the next step,
+ * so the solvers only evaluate 8 derivatives per step.
+ */
+struct Verner65 : ExplicitRungeKutta<Verner65Tableau> {
+  // Order of the continuous extension
+  static constexpr int kDenseOrder = 5;
+
+  template <int N>
+  using Interpolant = PolynomialInterpolant<N, 5>;
+
+  /**
+   * Returns the continuous extension of the step of size h from (t, x),
+   * given the derivatives dv at its start and dv1 at its end.
+   *
+   * Its weights are quintic polynomials that use the stages of the step
+   * and one more at its middle, evaluated at the quartic extension
+   * of the 9 stages (bootstrapping). It matches the values
+   * and the derivatives at both ends of the step.
+   */
+  template <IvpDerivative D>
+  inline Interpolant<D::kDim> interpolant(D f, double t,
+      const Vectord<D::kDim>& x, const Vectord<D::kDim>& dv, double h,
+      const Vectord<D::kDim>& dv1) const {
+    Vectord<D::kDim> k[kStages+1];
+    // The last stage is dv1
+    stages<kStages-1>(f, t, x, h, dv, k);
+    k[8] = dv1;
+    Vectord<D::kDim> y(x.size());
+    Combine<9>(x, h, k, [](auto j) { return kDenseA[j]; }, y);
+    k[9] = f(t + h/2, y);
+    return MakeInterpolant<10, 5>(t, x, h, k,
+        [](auto i, auto p) { return kDenseB[i][p]; });
+  }
+
+  // Row of the stage at the middle of the step
+  static constexpr double kDenseA[] = {
+    -509/15264.0, 0, 0, 15959/19404.0, -15625/10388.0, 8375/7056.0, 125/1056.0,
+    5/144.0, -1/8.0
+  };
+  // kDenseB[i][p] is the coefficient of th^(p+1) in the weight of k[i]
+  static constexpr double kDenseB[10][5] = {
+    {1, -6332947/1523856.0, 18751819/2285784.0, -2879245/380964.0,
+     246329/95241.0},
+    {},
+    {},
+    {0, 368132/46123.0, -10789672/415107.0, 1378500/46123.0, -1592224/138369.0},
+    {0, 562500/222229.0, 3375000/222229.0, -8437500/222229.0, 4500000/222229.0},
+    {0, 13975/100632.0, -602425/21564.0, 1426375/25158.0, -360400/12579.0},
+    {0, 223775/105424.0, -531775/158136.0, 40625/26356.0, -425/6589.0},
+    {0, 1829/4792.0, 19433/21564.0, -3115/1198.0, 2492/1797.0},
+    {0, -1, 1},
+    {0, -8, 32, -40, 16},
+  };
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_VERNER_65_HPP_
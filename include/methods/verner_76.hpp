@@ -0,0 +1,125 @@
+#ifndef INCLUDE_METHODS_VERNER_76_HPP_
+#define INCLUDE_METHODS_VERNER_76_HPP_
+
+#include "initial_value_problem.hpp"
+#include "methods/explicit_runge_kutta.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of Verner's "most efficient" 7(6) pair.
+ * b gives the seventh order solution and bHat the sixth order one.
+ */
+struct Verner76Tableau {
+  static constexpr int kOrder = 6;
+  static constexpr int kStages = 10;
+  static constexpr double c[] = {
+    0, 0.005, 0.10888888888888888, 0.16333333333333333, 0.4555,
+    0.6095094489978381, 0.884, 0.925, 1, 1
+  };
+  static constexpr double a[10][10] = {
+    {},
+    {0.005},
+    {-1.07679012345679, 1.185679012345679},
+    {0.04083333333333333, 0, 0.1225},
+    {0.6389139236255726, 0, -2.455672638223657, 2.272258714598084},
+    {-2.6615773750187572, 0, 10.804513886456137, -8.3539146573962,
+     0.820487594956657},
+    {6.067741434696772, 0, -24.711273635911088, 20.427517930788895,
+     -1.9061579788166472, 1.006172249242068},
+    {12.054670076253203, 0, -49.75478495046899, 41.142888638604674,
+     -4.461760149974004, 2.042334822239175, -0.09834843665406107},
+    {10.138146522881808, 0, -42.6411360317175, 35.76384003992257,
+     -4.3480228403929075, 2.0098622683770357, 0.3487490460338272,
+     -0.27143900510483127},
+    {-45.030072034298676, 0, 187.3272437654589, -154.02882369350186,
+     18.56465306347536, -7.141809679295079, 1.3088085781613787},
+  };
+  static constexpr double b[] = {
+    0.04715561848627222, 0, 0, 0.25750564298434153, 0.26216653977412624,
+    0.15216092656738558, 0.4939969170032485, -0.29430311714032503,
+    0.08131747232495111, 0
+  };
+  static constexpr double bHat[] = {
+    0.044608606606341174, 0, 0, 0.26716403785713727, 0.22010183001772932,
+    0.2188431703143157, 0.22898717054112028, 0, 0, 0.02029518466335628
+  };
+};
+
+/**
+ * Verner's 7(6) Method
+ * An adaptive Runge-Kutta method of order 7
+ *
+ * Advances with a seventh order solution of 10 stages
+ * and estimates the error with an embedded sixth order one.
+ */
+struct Verner76 : ExplicitRungeKutta<Verner76Tableau> {
+  // Order of the continuous extension
+  static constexpr int kDenseOrder = 6;
+
+  template <int N>
+  using Interpolant = PolynomialInterpolant<N, 6>;
+
+  /**
+   * Returns the continuous extension of the step of size h from (t, x),
+   * given the derivatives dv at its start and dv1 at its end.
+   *
+   * Its weights are sextic polynomials that use the stages of the step,
+   * dv1, and two more stages at a third and two thirds of the step,
+   * evaluated at the quintic extension of the former (bootstrapping).
+   * It matches the values and the derivatives at both ends of the step.
+   */
+  template <IvpDerivative D>
+  inline Interpolant<D::kDim> interpolant(D f, double t,
+      const Vectord<D::kDim>& x, const Vectord<D::kDim>& dv, double h,
+      const Vectord<D::kDim>& dv1) const {
+    Vectord<D::kDim> k[kStages+3];
+    stages(f, t, x, h, dv, k);
+    k[10] = dv1;
+    Vectord<D::kDim> y(x.size());
+    Combine<11>(x, h, k, [](auto j) { return kDenseA[0][j]; }, y);
+    k[11] = f(t + h/3, y);
+    Combine<11>(x, h, k, [](auto j) { return kDenseA[1][j]; }, y);
+    k[12] = f(t + 2*h/3, y);
+    return MakeInterpolant<13, 6>(t, x, h, k,
+        [](auto i, auto p) { return kDenseB[i][p]; });
+  }
+
+  // Rows of the stages at a third and two thirds of the step
+  static constexpr double kDenseA[2][11] = {
+    {0.05288306605998372, 0, 0, 0.2323933683800369, 0.09612032523097705,
+     -0.0670572057620219, 0.08645841025260483, -0.07630080814749168,
+     0.017066629994171426, 0, -0.008230452674926902},
+    {0.08220601384669646, 0, 0, 0.1463035137881874, 0.585178282611623,
+     -0.2673483283413365, 0.36162717009409595, -0.2180023089928334,
+     -0.05621948703912949, 0, 0.032921810699364173},
+  };
+  // kDenseB[i][p] is the coefficient of th^(p+1) in the weight of k[i]
+  static constexpr double kDenseB[13][6] = {
+    {1, -6.954795468988349, 20.910202084392967, -30.328631740119853,
+     21.028772813931834, -5.608392070730327},
+    {},
+    {},
+    {0, 15.007428873127282, -64.73691864626363, 107.58585763886032,
+     -79.44564097353282, 21.846778750793188},
+    {0, 8.844974718899746, -33.738212003531885, 45.19226812625883,
+     -22.97679987887624, 2.9399355770236717},
+    {0, 3.165130821920131, -9.739217046907012, 6.544755335590403,
+     4.380582741264018, -4.199090925300155},
+    {0, -1.1144570447591982, 25.332161903927055, -92.65406175313284,
+     116.73344747554079, -47.80309366457256},
+    {0, 1.6775277676998852, -20.159763524112932, 65.3352920051547,
+     -78.6672232116121, 31.519863845730114},
+    {0, -0.9758096678994953, 8.131747232495439, -23.17547961261157,
+     26.34686103328451, -10.246001512943934},
+    {},
+    {0, 0.6, -7, 22.75, -27.9, 11.55},
+    {0, -16.2, 81, -141.75, 105.3, -28.35},
+    {0, -4.05, 0, 40.5, -64.8, 28.35},
+  };
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_VERNER_76_HPP_
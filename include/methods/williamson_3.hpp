@@ -0,0 +1,35 @@
+#ifndef INCLUDE_METHODS_WILLIAMSON_3_HPP_
+#define INCLUDE_METHODS_WILLIAMSON_3_HPP_
+
+#include "methods/low_storage_runge_kutta.hpp"
+
+namespace odelib {
+
+/**
+ * Tableau of Williamson's third order low storage method.
+ *
+ *  i ┃   A[i]     B[i]   c[i]
+ * ━━━╋━━━━━━━━━━━━━━━━━━━━━━━
+ *  0 ┃     0      1/3     0
+ *  1 ┃  -5/9     15/16   1/3
+ *  2 ┃ -153/128   8/15   3/4
+ */
+struct Williamson3Tableau {
+  static constexpr int kOrder = 3;
+  static constexpr int kStages = 3;
+  static constexpr double A[] = {0, -5/9.0, -153/128.0};
+  static constexpr double B[] = {1/3.0, 15/16.0, 8/15.0};
+  static constexpr double c[] = {0, 1/3.0, 3/4.0};
+};
+
+/**
+ * Williamson's Third Order Low Storage Runge-Kutta Method
+ *
+ * Computes a third order approximation using 3 evaluations,
+ * keeping only two vectors of the size of the problem.
+ */
+using Williamson3 = LowStorageRungeKutta<Williamson3Tableau>;
+
+}  // namespace odelib
+
+#endif  // INCLUDE_METHODS_WILLIAMSON_3_HPP_
@@ -2,110 +2,176 @@
 #define INCLUDE_ODE_SOLUTION_HPP_
 
 #include <algorithm>
+#include <array>
 #include <concepts>
+#include <optional>
 #include <vector>
 #include "types.hpp"
 #include "tools/interpolation.hpp"
 
 namespace odelib {
 
-// TODO(edsa): developing a container that does not store
-// derivatives and integrating it into the rest of the system
-// is still pending.
 /**
  * A container to store numerical solutions to ODEs.
  * 
  * The container shall support basic operations,
  * as well as providing a way to determine whether
  * the derivatives at the solution's points need to be calculated.
+ * The points need not be stored as Vectord objects,
+ * but they must be convertible to them.
+ * Containers that do not store derivatives declare
+ * kStoresDerivatives = false and need not provide dv.
  */
 template <typename T>
 concept OdeSolution = requires(const T& ns, int i) {
   { T::kDim } -> std::same_as<const int&>;
+  { T::kStoresDerivatives } -> std::same_as<const bool&>;
   { ns.empty() } -> std::same_as<bool>;
   { ns.size() } -> std::same_as<size_t>;
+  { ns.containsDerivatives() } -> std::same_as<bool>;
   { ns.t[i] } -> std::convertible_to<double>;
-  { ns.x[i] } -> std::same_as<const Vectord<T::kDim>&>;
-  { ns.dv[i] } -> std::same_as<const Vectord<T::kDim>&>;
-};
+  { ns.x[i] } -> std::convertible_to<Vectord<T::kDim>>;
+} && (!T::kStoresDerivatives || requires(const T& ns, int i) {
+  { ns.dv[i] } -> std::convertible_to<Vectord<T::kDim>>;
+});
 
-template <OdeSolution Os>
-std::optional<Vectord<Os::kDim>> Interpolate(const Os& os, double time,
-    int order) {
-  int n = os.size();
-  int pos = lower_bound(os.t.begin(), os.t.end(), time) - os.t.begin();
-  if (pos == n || pos == 0) {
-    return {};
+/**
+ * An OdeSolution that stores the derivatives at its points.
+ * Required by the methods that use the derivatives of previous points,
+ * like multistep methods.
+ */
+template <typename T>
+concept OdeSolutionWithDerivatives = OdeSolution<T> && T::kStoresDerivatives;
+
+/**
+ * Resizes the solution to the given number of points.
+ * Returns whether it could, which only the containers whose resize
+ * returns bool may fail, like MappedOdeSolution.
+ */
+template <OdeSolution Sol>
+inline bool ResizeSolution(Sol& sol, size_t size) {
+  if constexpr (std::same_as<decltype(sol.resize(size)), bool>) {
+    return sol.resize(size);
+  } else {
+    sol.resize(size);
+    return true;
   }
-  if (order >= 0) {
-    const int nPoints = 4;
-    // If we don't have 4 points then interpolate with the ones we do have.
-    if (n < nPoints) {
-      return interpolation::Hermite(os.t, os.x, time);
-    }
-    // Points we try to use to interpolate if they exist
-    // First try with (pos-2 pos-1 pos pos+1)
-    // then           (pos-1 pos pos+1 pos+2)...
-    const int tries[] = {2, 1, 3, 0};
-    for (int id : tries) {
-      if (pos >= id && pos+nPoints-id <= n) {
-        std::vector<double> t(4);
-        std::vector<Vectord<Os::kDim>> x(4);
-        for (int i = 0; i < 4; ++i) {
-          t[i] = os.t[pos-id+i];
-          x[i] = os.x[pos-id+i];
-        }
-        return interpolation::Hermite(t, x, time);
-      }
+}
+
+/**
+ * Adds the point (t, x), with its derivative if given, to the solution.
+ * Returns whether it could, as ResizeSolution.
+ */
+template <OdeSolution Sol, typename... Dv>
+inline bool AddSolutionPoint(Sol& sol, double t, const Vectord<Sol::kDim>& x,
+    const Dv&... dv) {
+  if constexpr (std::same_as<decltype(sol.addPoint(t, x, dv...)), bool>) {
+    return sol.addPoint(t, x, dv...);
+  } else {
+    sol.addPoint(t, x, dv...);
+    return true;
+  }
+}
+
+/**
+ * Returns the index of the first point of the solution
+ * whose time is not less than the given time.
+ */
+template <OdeSolution Os>
+size_t LowerBoundTime(const Os& os, double time) {
+  size_t lo = 0, hi = os.size();
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo)/2;
+    if (os.t[mid] < time) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
-    // We cannot get here because there are at least nPoints points
   }
-  return {};
+  return lo;
 }
 
 /**
- * Returns the maximum difference between two OdeSolution.
- * 
- * The algorithm interpolates at the time of
- * each of the solution's points.
+ * Number of points used to interpolate a solution without derivatives.
  */
-template <OdeSolution Os1, OdeSolution Os2>
-double AbsDiff(Os1 lhs, Os2 rhs) {
-  double err = 0;
-  for (size_t i = 0; i < lhs.size(); ++i) {
-    err = std::max(err, (lhs.x[i] - interpolate(rhs, lhs.t[i])).norm());
+constexpr size_t kInterpolationPoints = 4;
+
+/**
+ * Returns the index of the first of the kInterpolationPoints points
+ * used to interpolate inside the step that ends at point pos,
+ * out of n points.
+ * The points (pos-2 pos-1 pos pos+1) are preferred,
+ * then (pos-1 pos pos+1 pos+2), (pos-3 pos-2 pos-1 pos)
+ * and (pos pos+1 pos+2 pos+3).
+ * If there are fewer points, all of them are used.
+ */
+inline size_t InterpolationWindow(size_t pos, size_t n) {
+  if (n < kInterpolationPoints) {
+    return 0;
   }
-  for (size_t i = 0; i < rhs.size(); ++i) {
-    err = std::max(err, (rhs.x[i] - interpolate(lhs, rhs.t[i])).norm());
+  const size_t tries[] = {2, 1, 3, 0};
+  for (size_t id : tries) {
+    if (pos >= id && pos+kInterpolationPoints-id <= n) {
+      return pos-id;
+    }
   }
-  return err;
+  // We cannot get here because there are at least 4 points
+  return 0;
 }
 
 /**
- * Returns the mean difference between two OdeSolution.
- * 
- * The algorithm interpolates at the time of
- * each of the solution's points.
+ * Interpolates the solution at the given time,
+ * which must lie after its first point and not after its last one.
+ *
+ * The solution is interpolated through 4 points around the time.
+ * With useDerivatives, if the solution contains derivatives,
+ * the cubic Hermite interpolant of the step that contains the time
+ * is used instead, which only depends on the two ends of the step.
+ * Nothing is allocated. See DenseOutput for repeated evaluations
+ * and InterpolateMany for many sorted times.
  */
-template <OdeSolution Os1, OdeSolution Os2>
-double MeanDiff(Os1 lhs, Os2 rhs) {
-  double err = 0;
-  for (size_t i = 0; i < lhs.size(); ++i) {
-    err += (lhs.x[i] - interpolate(rhs, lhs.t[i])).norm();
+template <OdeSolution Os>
+std::optional<Vectord<Os::kDim>> Interpolate(const Os& os, double time,
+    int order, bool useDerivatives = false) {
+  size_t n = os.size();
+  size_t pos = LowerBoundTime(os, time);
+  if (pos == n || pos == 0) {
+    return {};
   }
-  for (size_t i = 0; i < rhs.size(); ++i) {
-    err += (rhs.x[i] - interpolate(lhs, rhs.t[i])).norm();
+  if (order >= 0) {
+    if constexpr (Os::kStoresDerivatives) {
+      if (useDerivatives && os.containsDerivatives()) {
+        return interpolation::CubicHermite<Os::kDim>(os.t[pos-1],
+            os.x[pos-1], os.dv[pos-1], os.t[pos], os.x[pos], os.dv[pos],
+            time);
+      }
+    }
+    constexpr int K = kInterpolationPoints;
+    size_t first = InterpolationWindow(pos, n);
+    std::array<double, K> t;
+    std::array<Vectord<Os::kDim>, K> x;
+    // If we don't have 4 points then interpolate with the ones we do have.
+    size_t sz = std::min(n, kInterpolationPoints);
+    for (size_t i = 0; i < sz; ++i) {
+      t[i] = os.t[first+i];
+      x[i] = os.x[first+i];
+    }
+    if (sz < kInterpolationPoints) {
+      return interpolation::Hermite(t.data(), x.data(), sz, time);
+    }
+    return interpolation::Newton<K, Os::kDim>(t, x, time);
   }
-  err /= lhs.size()+rhs.size();
-  return err;
+  return {};
 }
 
 /**
  * Returns the maximum difference between
  * an OdeSolution and a analytical solution.
+ * See tools/solution_comparison.hpp to compare two OdeSolution.
  */
 template <OdeSolution Os, typename AnalyticalSolution>
-double AbsDiff(Os os, AnalyticalSolution as) {
+requires std::invocable<const AnalyticalSolution&, double>
+double AbsDiff(const Os& os, const AnalyticalSolution& as) {
   double err = 0;
   for (size_t i = 0; i < os.size(); ++i) {
     err = std::max(err, (os.x[i]-as(os.t[i])).norm());
@@ -118,7 +184,8 @@ double AbsDiff(Os os, AnalyticalSolution as) {
  * an OdeSolution and a analytical solution.
  */
 template <OdeSolution Os, typename AnalyticalSolution>
-double MeanDiff(Os os, AnalyticalSolution as) {
+requires std::invocable<const AnalyticalSolution&, double>
+double MeanDiff(const Os& os, const AnalyticalSolution& as) {
   double err = 0;
   for (size_t i = 0; i < os.size(); ++i) {
     err += (os.x[i]-as(os.t[i])).norm();
@@ -0,0 +1,84 @@
+#ifndef INCLUDE_PROBLEMS_BRUSSELATOR_HPP_
+#define INCLUDE_PROBLEMS_BRUSSELATOR_HPP_
+
+#include <cmath>
+#include <numbers>
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Brusselator with diffusion
+ * The reaction u' = 1 + u^2 v - 4u, v' = 3u - u^2 v
+ * with diffusion α = 1/50 on [0, 1], discretized on M interior
+ * points, as in Hairer and Wanner. The points alternate u and v.
+ * It gets stiffer with M, since the diffusion adds eigenvalues
+ * of size up to 4α(M+1)^2.
+ * Contains the partial derivatives of the function with respect to space,
+ * allowing to solve the problem using Newton's method, and time,
+ * which is null since the problem is autonomous.
+ */
+template <int M = 32>
+struct Brusselator {
+  static constexpr double kAlpha = 1/50.0;
+
+  static inline double t0() { return 0; }
+  static inline Vectord<2*M> x0() {
+    Vectord<2*M> x;
+    for (int i = 0; i < M; ++i) {
+      x[2*i] = 1 + std::sin(2*std::numbers::pi*(i+1)/(M+1));
+      x[2*i+1] = 3;
+    }
+    return x;
+  }
+
+  struct Dv {
+    static constexpr int kDim = 2*M;
+    static constexpr double kDiffusion = kAlpha*(M+1)*(M+1);
+
+    inline Vectord<2*M> operator()(double t, const Vectord<2*M>& x) const {
+      Vectord<2*M> dv;
+      for (int i = 0; i < M; ++i) {
+        double u = x[2*i];
+        double v = x[2*i+1];
+        // The boundary values are u = 1, v = 3
+        double u0 = i > 0? x[2*i-2] : 1;
+        double u1 = i < M-1? x[2*i+2] : 1;
+        double v0 = i > 0? x[2*i-1] : 3;
+        double v1 = i < M-1? x[2*i+3] : 3;
+        dv[2*i] = 1 + u*u*v - 4*u + kDiffusion*(u0 - 2*u + u1);
+        dv[2*i+1] = 3*u - u*u*v + kDiffusion*(v0 - 2*v + v1);
+      }
+      return dv;
+    }
+
+    inline Matrixd<2*M, 2*M> pdvx(double t, const Vectord<2*M>& x) const {
+      Matrixd<2*M, 2*M> jac = Matrixd<2*M, 2*M>::Zero();
+      for (int i = 0; i < M; ++i) {
+        double u = x[2*i];
+        double v = x[2*i+1];
+        jac(2*i, 2*i) = 2*u*v - 4 - 2*kDiffusion;
+        jac(2*i, 2*i+1) = u*u;
+        jac(2*i+1, 2*i) = 3 - 2*u*v;
+        jac(2*i+1, 2*i+1) = -u*u - 2*kDiffusion;
+        if (i > 0) {
+          jac(2*i, 2*i-2) = kDiffusion;
+          jac(2*i+1, 2*i-1) = kDiffusion;
+        }
+        if (i < M-1) {
+          jac(2*i, 2*i+2) = kDiffusion;
+          jac(2*i+1, 2*i+3) = kDiffusion;
+        }
+      }
+      return jac;
+    }
+
+    inline Vectord<2*M> pdvt(double t, const Vectord<2*M>& x) const {
+      return Vectord<2*M>::Zero();
+    }
+  };
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_PROBLEMS_BRUSSELATOR_HPP_
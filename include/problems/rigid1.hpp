@@ -8,8 +8,8 @@ namespace odelib {
 
 /**
  * A rigid/stiff problem of dimension 1.
- * Contains the partial derivative with respect to space of the function,
- * allowing to solve the problem using Newton's method.
+ * Contains the partial derivatives of the function with respect to space,
+ * allowing to solve the problem using Newton's method, and time.
  */
 struct Rigid1 {
   static inline double t0() { return 0; }
@@ -25,6 +25,11 @@ struct Rigid1 {
     inline Vectord<1> pdvx(double t, const Vectord<1>& x) const {
       return Vectord<1>{10*exp(5*t)*(x[0] - t)};
     }
+
+    inline Vectord<1> pdvt(double t, const Vectord<1>& x) const {
+      return Vectord<1>{25*exp(5*t)*(x[0] - t)*(x[0] - t)
+          - 10*exp(5*t)*(x[0] - t)};
+    }
   };
 
   static inline Vectord<1> analyticalSol(double t) {
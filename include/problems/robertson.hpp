@@ -0,0 +1,45 @@
+#ifndef INCLUDE_PROBLEMS_ROBERTSON_HPP_
+#define INCLUDE_PROBLEMS_ROBERTSON_HPP_
+
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Robertson's chemical reaction
+ * A stiff problem of dimension 3, whose reaction rates
+ * range from 0.04 to 3e7. The quantities add up to 1.
+ * Contains the partial derivatives of the function with respect to space,
+ * allowing to solve the problem using Newton's method, and time,
+ * which is null since the problem is autonomous.
+ */
+struct Robertson {
+  static inline double t0() { return 0; }
+  static inline Vectord<3> x0() { return {1, 0, 0}; }
+
+  struct Dv {
+    static constexpr int kDim = 3;
+
+    inline Vectord<3> operator()(double t, const Vectord<3>& x) const {
+      double slow = 0.04*x[0] - 1e4*x[1]*x[2];
+      double fast = 3e7*x[1]*x[1];
+      return {-slow, slow - fast, fast};
+    }
+
+    inline Matrixd<3, 3> pdvx(double t, const Vectord<3>& x) const {
+      Matrixd<3, 3> jac;
+      jac << -0.04, 1e4*x[2], 1e4*x[1],
+             0.04, -1e4*x[2] - 6e7*x[1], -1e4*x[1],
+             0, 6e7*x[1], 0;
+      return jac;
+    }
+
+    inline Vectord<3> pdvt(double t, const Vectord<3>& x) const {
+      return Vectord<3>::Zero();
+    }
+  };
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_PROBLEMS_ROBERTSON_HPP_
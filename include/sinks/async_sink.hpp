@@ -0,0 +1,236 @@
+#ifndef INCLUDE_SINKS_ASYNC_SINK_HPP_
+#define INCLUDE_SINKS_ASYNC_SINK_HPP_
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "solution_sink.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * What an AsyncSink does with a point when its queue is full.
+ */
+enum class Backpressure {
+  kBlock,  // Wait until the writer thread makes room
+  kDrop,   // Drop the point and count it
+};
+
+/**
+ * AsyncSink
+ *
+ * A SolutionSink that hands everything it receives to another sink
+ * running on a writer thread of its own, so that the integration
+ * and the output overlap.
+ * Both threads communicate through a bounded lock-free
+ * single-producer single-consumer queue. The writer drains it in blocks
+ * and only sleeps when it finds it empty.
+ *
+ * When the queue is full, the solver thread either waits
+ * or drops the point, depending on the Backpressure policy.
+ * Rejected steps and the result are never dropped.
+ * onFinished returns only after every queued event
+ * has reached the inner sink, including its own onFinished,
+ * so the output is complete once the solver returns.
+ * The inner sink must not be accessed until then.
+ * Inner can be a reference to a sink that lives elsewhere.
+ */
+template <int N, SolutionSink<N> Inner>
+class AsyncSink {
+ public:
+  static constexpr int kDim = N;
+
+  explicit AsyncSink(Inner inner, size_t capacity = 1 << 14,
+      Backpressure backpressure = Backpressure::kBlock)
+    : inner_(std::forward<Inner>(inner)), backpressure_(backpressure) {
+    size_t size = 2;
+    while (size < capacity) {
+      size *= 2;
+    }
+    queue_.resize(size);
+    mask_ = size - 1;
+    writer_ = std::thread([this]() { drain(); });
+  }
+
+  AsyncSink(const AsyncSink&) = delete;
+  AsyncSink& operator=(const AsyncSink&) = delete;
+
+  /**
+   * Stops the writer thread after it drains the queue.
+   * The inner sink is not told that the integration finished.
+   */
+  ~AsyncSink() {
+    if (writer_.joinable()) {
+      acquire().kind = Event::kStop;
+      publish();
+      writer_.join();
+    }
+  }
+
+  inline void onPointAccepted(double t, const Vectord<N>& x) {
+    if (backpressure_ == Backpressure::kDrop && full()) {
+      ++dropped_;
+      return;
+    }
+    Event& event = acquire();
+    event.kind = Event::kPoint;
+    event.t = t;
+    event.x = x;
+    publish();
+  }
+
+  inline void onStepRejected(double t, double h) {
+    Event& event = acquire();
+    event.kind = Event::kRejected;
+    event.t = t;
+    event.h = h;
+    publish();
+  }
+
+  void onFinished(SolverResult result) {
+    Event& event = acquire();
+    event.kind = Event::kFinished;
+    event.result = result;
+    publish();
+    writer_.join();
+  }
+
+  /**
+   * The sink that received the events, once the integration finished.
+   */
+  inline Inner& inner() { return inner_; }
+  inline const Inner& inner() const { return inner_; }
+
+  /**
+   * Number of points dropped because the queue was full.
+   */
+  inline size_t dropped() const { return dropped_; }
+
+ private:
+  struct Event {
+    enum Kind { kPoint, kRejected, kFinished, kStop };
+
+    Kind kind = kStop;
+    double t = 0;
+    double h = 0;
+    Vectord<N> x = Vectord<N>::Zero();
+    SolverResult result = SolverResult::kOk;
+  };
+
+  // Only the solver thread calls these
+
+  inline bool full() {
+    if (tail_ - headCache_ <= mask_) {
+      return false;
+    }
+    headCache_ = head_.load(std::memory_order_acquire);
+    return tail_ - headCache_ > mask_;
+  }
+
+  // Waits for room and returns the slot of the next event
+  inline Event& acquire() {
+    while (full()) {
+      Wait(head_, headCache_, producerWaiting_);
+    }
+    return queue_[tail_ & mask_];
+  }
+
+  inline void publish() {
+    published_.store(++tail_, std::memory_order_release);
+    Wake(published_, consumerWaiting_);
+  }
+
+  // Only the writer thread calls this
+
+  void drain() {
+    size_t head = 0;
+    size_t available = 0;
+    for (;;) {
+      if (head == available) {
+        available = published_.load(std::memory_order_acquire);
+        if (head == available) {
+          Wait(published_, available, consumerWaiting_);
+          continue;
+        }
+      }
+      // Forward the whole block that is available
+      for (; head != available; ++head) {
+        Event& event = queue_[head & mask_];
+        switch (event.kind) {
+          case Event::kPoint:
+            inner_.onPointAccepted(event.t, event.x);
+            break;
+          case Event::kRejected:
+            inner_.onStepRejected(event.t, event.h);
+            break;
+          case Event::kFinished:
+            inner_.onFinished(event.result);
+            return;
+          case Event::kStop:
+            return;
+        }
+        if ((head & 255) == 255) {
+          release(head + 1);
+        }
+      }
+      release(head);
+    }
+  }
+
+  inline void release(size_t head) {
+    head_.store(head, std::memory_order_release);
+    Wake(head_, producerWaiting_);
+  }
+
+  // Sleeps until index changes from seen, after announcing it with waiting.
+  // The announcement and the fence in Wake are sequentially consistent,
+  // so either the waker sees it or the new value is seen here.
+  static void Wait(std::atomic<size_t>& index, size_t& seen,
+      std::atomic<bool>& waiting) {
+    for (int i = 0; i < 64; ++i) {
+      size_t now = index.load(std::memory_order_acquire);
+      if (now != seen) {
+        seen = now;
+        return;
+      }
+      std::this_thread::yield();
+    }
+    waiting.store(true);
+    if (index.load() == seen) {
+      index.wait(seen);
+    }
+    waiting.store(false);
+    seen = index.load(std::memory_order_acquire);
+  }
+
+  static inline void Wake(std::atomic<size_t>& index,
+      std::atomic<bool>& waiting) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed)) {
+      index.notify_one();
+    }
+  }
+
+  static constexpr size_t kLine = 64;
+
+  Inner inner_;
+  Backpressure backpressure_;
+  std::vector<Event> queue_;
+  size_t mask_;
+  // Written by the solver thread
+  alignas(kLine) std::atomic<size_t> published_ = 0;
+  std::atomic<bool> producerWaiting_ = false;
+  size_t tail_ = 0;
+  size_t headCache_ = 0;
+  size_t dropped_ = 0;
+  // Written by the writer thread
+  alignas(kLine) std::atomic<size_t> head_ = 0;
+  std::atomic<bool> consumerWaiting_ = false;
+  alignas(kLine) std::thread writer_;
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SINKS_ASYNC_SINK_HPP_
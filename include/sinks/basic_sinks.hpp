@@ -0,0 +1,183 @@
+#ifndef INCLUDE_SINKS_BASIC_SINKS_HPP_
+#define INCLUDE_SINKS_BASIC_SINKS_HPP_
+
+#include <iostream>
+#include <utility>
+#include "ode_solution.hpp"
+#include "solution_sink.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * A SolutionSink that only remembers the last accepted point,
+ * how many steps were accepted and rejected, and the result.
+ */
+template <int N>
+struct LastPointSink {
+  static constexpr int kDim = N;
+
+  inline void onPointAccepted(double t, const Vectord<N>& x) {
+    this->t = t;
+    this->x = x;
+    ++accepted;
+  }
+
+  inline void onStepRejected(double t, double h) { ++rejected; }
+
+  inline void onFinished(SolverResult result) { this->result = result; }
+
+  double t = 0;
+  Vectord<N> x = Vectord<N>::Zero();
+  size_t accepted = 0;
+  size_t rejected = 0;
+  SolverResult result = SolverResult::kOk;
+};
+
+/**
+ * A SolutionSink that forwards one of every k accepted points
+ * to another sink, starting with the k-th.
+ * The last point is always forwarded when the integration finishes,
+ * so that the final state is never lost.
+ * Rejected steps and the result are forwarded as they are.
+ */
+template <int N, SolutionSink<N> Inner>
+class EveryKthPointSink {
+ public:
+  static constexpr int kDim = N;
+
+  EveryKthPointSink(size_t k, Inner inner)
+    : inner(std::move(inner)), k_(k > 0? k : 1) {}
+
+  inline void onPointAccepted(double t, const Vectord<N>& x) {
+    if (++count_ == k_) {
+      inner.onPointAccepted(t, x);
+      count_ = 0;
+    } else {
+      lastT_ = t;
+      lastX_ = x;
+    }
+  }
+
+  inline void onStepRejected(double t, double h) {
+    inner.onStepRejected(t, h);
+  }
+
+  inline void onFinished(SolverResult result) {
+    if (count_ != 0) {
+      inner.onPointAccepted(lastT_, lastX_);
+      count_ = 0;
+    }
+    inner.onFinished(result);
+  }
+
+  Inner inner;
+
+ private:
+  size_t k_;
+  size_t count_ = 0;
+  double lastT_ = 0;
+  Vectord<N> lastX_;
+};
+
+/**
+ * A SolutionSink that forwards to another sink the solution
+ * at the times t0, t0 + dt, t0 + 2 dt, ... until the last point,
+ * evaluated with the continuous extension of every accepted step
+ * instead of the points themselves.
+ * It needs a method whose interpolants the solver hands to the sinks
+ * (see SolutionSink), and t0 not before the start of the integration.
+ * Rejected steps and the result are forwarded as they are.
+ */
+template <int N, SolutionSink<N> Inner>
+class SamplingSink {
+ public:
+  static constexpr int kDim = N;
+
+  SamplingSink(double t0, double dt, Inner inner)
+    : inner(std::move(inner)), t0_(t0), dt_(dt) {}
+
+  inline void onPointAccepted(double t, const Vectord<N>& x) {
+    accepted_ = true;
+  }
+
+  template <typename In>
+  inline void onStepInterpolated(const In& in) {
+    interpolated_ = true;
+    double end = in.t0 + in.h;
+    // From the count, so that the rounding of the times does not add up
+    for (double t = t0_ + count_*dt_; t <= end; t = t0_ + count_*dt_) {
+      inner.onPointAccepted(t, in(t));
+      ++count_;
+    }
+  }
+
+  inline void onStepRejected(double t, double h) {
+    inner.onStepRejected(t, h);
+  }
+
+  inline void onFinished(SolverResult result) {
+    if (accepted_ && !interpolated_) {
+      std::cerr << "SamplingSink: the solver handed no interpolants"
+          << std::endl;
+    }
+    inner.onFinished(result);
+  }
+
+  Inner inner;
+
+ private:
+  double t0_;
+  double dt_;
+  size_t count_ = 0;
+  bool accepted_ = false;
+  bool interpolated_ = false;
+};
+
+/**
+ * A SolutionSink that hands every accepted point to a callable
+ * taking (double t, const Vectord<N>& x).
+ */
+template <typename F>
+struct CallbackSink {
+  template <int N>
+  inline void onPointAccepted(double t, const Vectord<N>& x) {
+    callback(t, x);
+  }
+
+  inline void onStepRejected(double t, double h) {}
+  inline void onFinished(SolverResult result) {}
+
+  F callback;
+};
+
+template <typename F>
+CallbackSink(F) -> CallbackSink<F>;
+
+/**
+ * A SolutionSink that appends the accepted points to an OdeSolution.
+ * Combined with EveryKthPointSink it stores a thinned trajectory.
+ * If the solution cannot grow, failed is set and the point is lost.
+ */
+template <OdeSolution Sol>
+struct AppendToSolution {
+  static constexpr int kDim = Sol::kDim;
+
+  explicit AppendToSolution(Sol& sol) : sol(sol) {}
+
+  inline void onPointAccepted(double t, const Vectord<kDim>& x) {
+    if (!AddSolutionPoint(sol, t, x)) {
+      failed = true;
+    }
+  }
+
+  inline void onStepRejected(double t, double h) {}
+  inline void onFinished(SolverResult result) {}
+
+  Sol& sol;
+  bool failed = false;
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SINKS_BASIC_SINKS_HPP_
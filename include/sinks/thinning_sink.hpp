@@ -0,0 +1,139 @@
+#ifndef INCLUDE_SINKS_THINNING_SINK_HPP_
+#define INCLUDE_SINKS_THINNING_SINK_HPP_
+
+#include <algorithm>
+#include "initial_value_problem.hpp"
+#include "ode_solution.hpp"
+#include "solution_sink.hpp"
+#include "tools/interpolation.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * ThinningSink
+ *
+ * A SolutionSink that appends to an OdeSolution only the points
+ * that cannot be rebuilt from the stored ones.
+ * An accepted point is dropped while the cubic Hermite interpolant
+ * between the last stored point and the newest one reproduces it,
+ * and every other point dropped since, within maxError.
+ * The derivatives are evaluated with f and stored with the points,
+ * so DenseOutput rebuilds the dropped points with that same interpolant.
+ * The one at the last point of the solution is given by the solver,
+ * which already has it. See ThinningExtendPastMaxTime.
+ *
+ * At most MaxDropped consecutive points are dropped,
+ * so the sink never allocates. The last point is always stored
+ * when the integration finishes.
+ */
+template <OdeSolution Sol, IvpDerivative D, int MaxDropped = 256>
+class ThinningSink {
+ public:
+  static constexpr int kDim = Sol::kDim;
+
+  ThinningSink(Sol& sol, const D& f, const Vectord<kDim>& dv,
+      double maxError)
+    : sol_(sol), f_(f), maxError_(maxError), kT_(sol.t.back()),
+      kX_(sol.x.back()), kDv_(dv) {}
+
+  void onPointAccepted(double t, const Vectord<kDim>& x) {
+    Vectord<kDim> dv = f_(t, x);
+    if (pending_ && dropped_ < MaxDropped) {
+      double err = reconstructionError(t, x, dv);
+      if (err <= maxError_) {
+        droppedT_[dropped_] = pT_;
+        droppedX_[dropped_] = pX_;
+        ++dropped_;
+        pendingError_ = err;
+        setPending(t, x, dv);
+        return;
+      }
+    }
+    if (pending_) {
+      store();
+    }
+    setPending(t, x, dv);
+  }
+
+  inline void onStepRejected(double t, double h) {}
+
+  inline void onFinished(SolverResult result) {
+    if (pending_) {
+      store();
+    }
+  }
+
+  /**
+   * The maximum error with which the dropped points can be rebuilt.
+   */
+  inline double maxReconstructionError() const { return error_; }
+  inline size_t stored() const { return stored_; }
+  // Whether some point could not be stored, see ResizeSolution
+  inline bool failed() const { return failed_; }
+  inline size_t dropped() const { return totalDropped_; }
+
+ private:
+  // Maximum error of the interpolant from the last stored point to (t, x)
+  // at the pending point and at the points dropped since
+  double reconstructionError(double t, const Vectord<kDim>& x,
+      const Vectord<kDim>& dv) const {
+    double err = (interpolation::CubicHermite(kT_, kX_, kDv_, t, x, dv, pT_)
+        - pX_).norm();
+    for (int i = 0; i < dropped_; ++i) {
+      err = std::max(err, (interpolation::CubicHermite(kT_, kX_, kDv_, t, x,
+          dv, droppedT_[i]) - droppedX_[i]).norm());
+    }
+    return err;
+  }
+
+  inline void setPending(double t, const Vectord<kDim>& x,
+      const Vectord<kDim>& dv) {
+    pending_ = true;
+    pT_ = t;
+    pX_ = x;
+    pDv_ = dv;
+  }
+
+  // Stores the pending point, which becomes the last stored one
+  inline void store() {
+    if (!AddSolutionPoint(sol_, pT_, pX_, pDv_)) {
+      failed_ = true;
+    }
+    kT_ = pT_;
+    kX_ = pX_;
+    kDv_ = pDv_;
+    error_ = std::max(error_, pendingError_);
+    totalDropped_ += dropped_;
+    ++stored_;
+    pendingError_ = 0;
+    dropped_ = 0;
+    pending_ = false;
+  }
+
+  Sol& sol_;
+  D f_;
+  double maxError_;
+  // Last stored point
+  double kT_;
+  Vectord<kDim> kX_;
+  Vectord<kDim> kDv_;
+  // Newest point, which is stored only if the next one cannot replace it
+  bool pending_ = false;
+  double pT_ = 0;
+  Vectord<kDim> pX_;
+  Vectord<kDim> pDv_;
+  double pendingError_ = 0;
+  // Points dropped since the last stored one
+  int dropped_ = 0;
+  double droppedT_[MaxDropped];
+  Vectord<kDim> droppedX_[MaxDropped];
+  double error_ = 0;
+  size_t stored_ = 0;
+  size_t totalDropped_ = 0;
+  bool failed_ = false;
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SINKS_THINNING_SINK_HPP_
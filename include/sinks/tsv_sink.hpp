@@ -0,0 +1,95 @@
+#ifndef INCLUDE_SINKS_TSV_SINK_HPP_
+#define INCLUDE_SINKS_TSV_SINK_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "solution_sink.hpp"
+#include "tools/fast_tsv_output.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * TsvSink
+ *
+ * A SolutionSink that prints the accepted points with tsv format,
+ * the time followed by the desired indices, as they arrive.
+ * Values are printed with their shortest round-trip representation
+ * into a buffer that is written once it fills up
+ * and when the integration finishes.
+ */
+template <int N>
+class TsvSink {
+ public:
+  static constexpr int kDim = N;
+
+  TsvSink(std::ostream& out, std::vector<int> indices,
+      size_t bufferSize = 1 << 16)
+    : out_(out), indices_(std::move(indices)) {
+    for (int id : indices_) {
+      assert(0 <= id && id < N);
+    }
+    rowSize_ = (indices_.size() + 1)*(tsv::kMaxDoubleChars + 1);
+    buffer_.resize(std::max(bufferSize, rowSize_));
+  }
+
+  /**
+   * Prints every index.
+   */
+  explicit TsvSink(std::ostream& out) : TsvSink(out, AllIndices()) {}
+
+  TsvSink(const TsvSink&) = delete;
+  TsvSink& operator=(const TsvSink&) = delete;
+
+  ~TsvSink() { flush(); }
+
+  void onPointAccepted(double t, const Vectord<N>& x) {
+    if (buffer_.size() - size_ < rowSize_) {
+      flush();
+    }
+    char* p = tsv::PutDouble(buffer_.data() + size_, t);
+    for (int id : indices_) {
+      *p++ = '\t';
+      p = tsv::PutDouble(p, x[id]);
+    }
+    *p++ = '\n';
+    size_ = p - buffer_.data();
+  }
+
+  inline void onStepRejected(double t, double h) {}
+
+  inline void onFinished(SolverResult result) {
+    flush();
+    out_.flush();
+  }
+
+  /**
+   * Writes the buffered rows.
+   */
+  void flush() {
+    out_.write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static std::vector<int> AllIndices() {
+    std::vector<int> ind(N);
+    for (int i = 0; i < N; ++i) {
+      ind[i] = i;
+    }
+    return ind;
+  }
+
+  std::ostream& out_;
+  std::vector<int> indices_;
+  size_t rowSize_;
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SINKS_TSV_SINK_HPP_
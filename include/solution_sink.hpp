@@ -0,0 +1,53 @@
+#ifndef INCLUDE_SOLUTION_SINK_HPP_
+#define INCLUDE_SOLUTION_SINK_HPP_
+
+#include <concepts>
+#include "solvers/types.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * A SolutionSink.
+ * An object that observes an integration as it happens
+ * instead of having its points stored in an OdeSolution.
+ *
+ * The solvers call onPointAccepted with every point they accept,
+ * onStepRejected with the time and size of every step they discard,
+ * and onFinished once, with the result of the integration.
+ *
+ * The one-step solvers stream through their StreamPast* functions
+ * (NewtonStreamPast* for the implicit methods).
+ * The methods that need the last points, the multistep ones, the BDFs
+ * and the secant iteration, stream by extending a HistoryWindow, which
+ * hands the points it evicts to the sink. Those only stream up to the
+ * maximum time: their ExtendPastZero still needs a whole OdeSolution.
+ *
+ * A sink may also take the continuous extension of every accepted step,
+ * right after its point, through onStepInterpolated(in),
+ * where in(t) is the solution at any time t in the step.
+ * The adaptive solvers hand it for the methods whose cache keeps
+ * the stages of the accepted step, like the Rosenbrock methods,
+ * so it costs no evaluations. See SamplingSink.
+ */
+template <typename S, int N>
+concept SolutionSink = requires(S& sink, double t, const Vectord<N>& x,
+    double h, SolverResult result) {
+  sink.onPointAccepted(t, x);
+  sink.onStepRejected(t, h);
+  sink.onFinished(result);
+};
+
+/**
+ * A SolutionSink that ignores everything.
+ */
+struct DiscardSink {
+  template <int N>
+  inline void onPointAccepted(double t, const Vectord<N>& x) {}
+  inline void onStepRejected(double t, double h) {}
+  inline void onFinished(SolverResult result) {}
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SOLUTION_SINK_HPP_
@@ -0,0 +1,248 @@
+#ifndef INCLUDE_SOLUTIONS_CHUNKED_ODE_SOLUTION_HPP_
+#define INCLUDE_SOLUTIONS_CHUNKED_ODE_SOLUTION_HPP_
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "initial_value_problem.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Layout of the points inside each chunk of a ChunkedOdeSolution.
+ *
+ * Both layouts keep the times in a column of their own.
+ * kSoA also stores every component of x and dv in its own column,
+ * which favours algorithms that sweep a single component.
+ * kAoSoA stores x and dv as blocks of kDim-wide rows,
+ * so that each point is contiguous in memory.
+ */
+enum class SolutionLayout { kSoA, kAoSoA };
+
+/**
+ * Addressing of the points stored in a chunk of Rows points.
+ *
+ * A chunk is a single buffer of Rows*(1 + 2*N) doubles:
+ * the time column, followed by the x block and the dv block.
+ */
+template <int N, SolutionLayout Layout, int Rows>
+struct SolutionChunkFormat {
+  static_assert(Rows > 0 && Rows % 8 == 0,
+      "Chunks must hold a multiple of 8 points to keep blocks aligned");
+
+  static constexpr int kRows = Rows;
+  static constexpr size_t kDoubles = static_cast<size_t>(Rows)*(1 + 2*N);
+  static constexpr size_t kBytes = kDoubles*sizeof(double);
+  static constexpr size_t kAlignment = 64;
+  static constexpr int kXOffset = Rows;
+  static constexpr int kDvOffset = Rows*(1 + N);
+  // Distance between two components of the same point
+  // and between the first components of two consecutive points
+  static constexpr int kComponentStride = Layout == SolutionLayout::kSoA?
+      Rows : 1;
+  static constexpr int kRowStride = Layout == SolutionLayout::kSoA? 1 : N;
+
+  using Row = Eigen::Map<Vectord<N>, Eigen::Unaligned,
+      Eigen::InnerStride<kComponentStride>>;
+  using ConstRow = Eigen::Map<const Vectord<N>, Eigen::Unaligned,
+      Eigen::InnerStride<kComponentStride>>;
+
+  static inline double* time(double* chunk, int row) { return chunk + row; }
+
+  static inline Row row(double* chunk, int offset, int row) {
+    return Row(chunk + offset + row*kRowStride);
+  }
+
+  static inline ConstRow row(const double* chunk, int offset, int row) {
+    return ConstRow(chunk + offset + row*kRowStride);
+  }
+};
+
+/**
+ * ChunkedOdeSolution
+ *
+ * An OdeSolution that stores time, point and derivative
+ * in a list of aligned chunks of a fixed number of points.
+ * Growing the solution allocates a new chunk
+ * and never copies the points already stored.
+ *
+ * The columns t, x and dv are lightweight views
+ * which can be indexed like the vectors of StandardOdeSolution.
+ * Since the points of a chunked solution are not contiguous,
+ * the solution cannot be used with the multistep solvers,
+ * which address the history through pointers.
+ */
+template <int N, SolutionLayout Layout = SolutionLayout::kAoSoA,
+    int ChunkRows = 4096>
+class ChunkedOdeSolution {
+ public:
+  using Format = SolutionChunkFormat<N, Layout, ChunkRows>;
+
+  static constexpr int kDim = N;
+  static constexpr bool kStoresDerivatives = true;
+  static constexpr SolutionLayout kLayout = Layout;
+
+  class TimeColumn {
+   public:
+    inline double& operator[](size_t i) { return *sol_->time(i); }
+    inline double operator[](size_t i) const { return *sol_->time(i); }
+    inline double& back() { return (*this)[sol_->size_-1]; }
+    inline double back() const { return (*this)[sol_->size_-1]; }
+    inline size_t size() const { return sol_->size_; }
+
+   private:
+    friend class ChunkedOdeSolution;
+    explicit TimeColumn(ChunkedOdeSolution* sol) : sol_(sol) {}
+    ChunkedOdeSolution* sol_;
+  };
+
+  class PointColumn {
+   public:
+    using Row = typename Format::Row;
+    using ConstRow = typename Format::ConstRow;
+
+    inline Row operator[](size_t i) { return sol_->row(offset_, i); }
+    inline ConstRow operator[](size_t i) const {
+      return std::as_const(*sol_).row(offset_, i);
+    }
+    inline Row back() { return (*this)[sol_->size_-1]; }
+    inline ConstRow back() const { return (*this)[sol_->size_-1]; }
+    inline size_t size() const { return sol_->size_; }
+
+   private:
+    friend class ChunkedOdeSolution;
+    PointColumn(ChunkedOdeSolution* sol, int offset)
+      : sol_(sol), offset_(offset) {}
+    ChunkedOdeSolution* sol_;
+    int offset_;
+  };
+
+  ChunkedOdeSolution()
+    : t(this), x(this, Format::kXOffset), dv(this, Format::kDvOffset) {}
+
+  ChunkedOdeSolution(const ChunkedOdeSolution& other) : ChunkedOdeSolution() {
+    *this = other;
+  }
+
+  ChunkedOdeSolution(ChunkedOdeSolution&& other) : ChunkedOdeSolution() {
+    *this = std::move(other);
+  }
+
+  ChunkedOdeSolution& operator=(const ChunkedOdeSolution& other) {
+    if (this != &other) {
+      reserve(other.size_);
+      for (size_t c = 0; c*ChunkRows < other.size_; ++c) {
+        CopyRows(chunks_[c].get(), other.chunks_[c].get(),
+            std::min<size_t>(other.size_ - c*ChunkRows, ChunkRows));
+      }
+      size_ = other.size_;
+      dvSize_ = other.dvSize_;
+    }
+    return *this;
+  }
+
+  ChunkedOdeSolution& operator=(ChunkedOdeSolution&& other) {
+    chunks_.swap(other.chunks_);
+    std::swap(size_, other.size_);
+    std::swap(dvSize_, other.dvSize_);
+    return *this;
+  }
+
+  inline size_t size() const { return size_; }
+  inline bool empty() const { return size_ == 0; }
+  inline bool containsDerivatives() const { return size_ == dvSize_; }
+  inline size_t capacity() const { return chunks_.size()*ChunkRows; }
+
+  inline void reserve(size_t size) {
+    while (capacity() < size) {
+      void* chunk = std::aligned_alloc(Format::kAlignment, Format::kBytes);
+      if (chunk == nullptr) {
+        throw std::bad_alloc();
+      }
+      chunks_.emplace_back(static_cast<double*>(chunk));
+    }
+  }
+
+  inline void resize(size_t size) {
+    reserve(size);
+    size_ = size;
+    dvSize_ = size;
+  }
+
+  inline void addPoint(double t, const Vectord<N>& x) {
+    reserve(size_+1);
+    *time(size_) = t;
+    row(Format::kXOffset, size_) = x;
+    ++size_;
+  }
+
+  inline void addPoint(double t, const Vectord<N>& x, const Vectord<N>& dv) {
+    reserve(size_+1);
+    *time(size_) = t;
+    row(Format::kXOffset, size_) = x;
+    row(Format::kDvOffset, size_) = dv;
+    ++size_;
+    ++dvSize_;
+  }
+
+  TimeColumn t;
+  PointColumn x;
+  PointColumn dv;
+
+ private:
+  struct FreeDeleter {
+    void operator()(double* chunk) const { std::free(chunk); }
+  };
+
+  // Copies the first rows points of the chunk src into dst
+  static void CopyRows(double* dst, const double* src, size_t rows) {
+    std::memcpy(dst, src, rows*sizeof(double));
+    for (int offset : {Format::kXOffset, Format::kDvOffset}) {
+      if constexpr (Layout == SolutionLayout::kSoA) {
+        for (int j = 0; j < N; ++j) {
+          std::memcpy(dst + offset + j*ChunkRows, src + offset + j*ChunkRows,
+              rows*sizeof(double));
+        }
+      } else {
+        std::memcpy(dst + offset, src + offset, rows*N*sizeof(double));
+      }
+    }
+  }
+
+  inline double* time(size_t i) const {
+    return Format::time(chunks_[i/ChunkRows].get(), i%ChunkRows);
+  }
+
+  inline typename Format::Row row(int offset, size_t i) {
+    return Format::row(chunks_[i/ChunkRows].get(), offset, i%ChunkRows);
+  }
+
+  inline typename Format::ConstRow row(int offset, size_t i) const {
+    return Format::row(static_cast<const double*>(chunks_[i/ChunkRows].get()),
+        offset, i%ChunkRows);
+  }
+
+  std::vector<std::unique_ptr<double, FreeDeleter>> chunks_;
+  size_t size_ = 0;
+  // Number of points added with their derivative, as the size of the dv
+  // vector of StandardOdeSolution, so that both report the same
+  // containsDerivatives after the same operations
+  size_t dvSize_ = 0;
+};
+
+template <SolutionLayout Layout = SolutionLayout::kAoSoA,
+    InitialValueProblem Ivp>
+ChunkedOdeSolution<Ivp::Dv::kDim, Layout> ChunkedOdeSolutionFromIvp(Ivp ivp) {
+  ChunkedOdeSolution<Ivp::Dv::kDim, Layout> sol;
+  sol.addPoint(ivp.t0(), ivp.x0(), typename Ivp::Dv()(ivp.t0(), ivp.x0()));
+  return sol;
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SOLUTIONS_CHUNKED_ODE_SOLUTION_HPP_
@@ -0,0 +1,63 @@
+#ifndef INCLUDE_SOLUTIONS_DERIVATIVE_FREE_ODE_SOLUTION_HPP_
+#define INCLUDE_SOLUTIONS_DERIVATIVE_FREE_ODE_SOLUTION_HPP_
+
+#include <vector>
+#include "initial_value_problem.hpp"
+
+namespace odelib {
+
+/**
+ * DerivativeFreeOdeSolution
+ *
+ * An OdeSolution that stores time and point in two independent vectors
+ * and never stores derivatives.
+ * The solvers detect it through kStoresDerivatives and
+ * skip evaluating the derivative at each new point.
+ * It cannot be used with multistep methods.
+ */
+template <int N>
+struct DerivativeFreeOdeSolution {
+  static constexpr int kDim = N;
+  static constexpr bool kStoresDerivatives = false;
+
+  DerivativeFreeOdeSolution() {}
+
+  inline size_t size() const { return t.size(); }
+  inline bool empty() const { return t.empty(); }
+  inline bool containsDerivatives() const { return false; }
+
+  inline void reserve(size_t size) {
+    t.reserve(size);
+    x.reserve(size);
+  }
+
+  inline void resize(size_t size) {
+    t.resize(size);
+    x.resize(size);
+  }
+
+  inline void addPoint(double t, const Vectord<N>& x) {
+    this->t.push_back(t);
+    this->x.push_back(x);
+  }
+
+  // The derivative is discarded
+  inline void addPoint(double t, const Vectord<N>& x, const Vectord<N>& dv) {
+    addPoint(t, x);
+  }
+
+  std::vector<double> t;
+  std::vector<Vectord<N>> x;
+};
+
+template <InitialValueProblem Ivp>
+DerivativeFreeOdeSolution<Ivp::Dv::kDim> DerivativeFreeOdeSolutionFromIvp(
+    Ivp ivp) {
+  DerivativeFreeOdeSolution<Ivp::Dv::kDim> sol;
+  sol.addPoint(ivp.t0(), ivp.x0());
+  return sol;
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SOLUTIONS_DERIVATIVE_FREE_ODE_SOLUTION_HPP_
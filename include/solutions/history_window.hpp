@@ -0,0 +1,131 @@
+#ifndef INCLUDE_SOLUTIONS_HISTORY_WINDOW_HPP_
+#define INCLUDE_SOLUTIONS_HISTORY_WINDOW_HPP_
+
+#include "initial_value_problem.hpp"
+#include "solution_sink.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * A column of a HistoryWindow.
+ *
+ * Each value is written twice, at positions i and i + Size,
+ * so that the last Size values are always contiguous in memory.
+ */
+template <typename T, int Size>
+class RingColumn {
+ public:
+  inline const T& operator[](size_t i) const { return data_[begin_ + i]; }
+  inline const T& front() const { return data_[begin_]; }
+  inline const T& back() const { return data_[begin_ + size_ - 1]; }
+  inline const T* data() const { return data_ + begin_; }
+  inline size_t size() const { return size_; }
+
+ private:
+  template <int N, int S>
+  friend class HistoryWindow;
+
+  inline void push(const T& value) {
+    int slot = (begin_ + size_) % Size;
+    data_[slot] = data_[slot + Size] = value;
+    if (size_ == Size) {
+      begin_ = (begin_ + 1) % Size;
+    } else {
+      ++size_;
+    }
+  }
+
+  inline void pop(int n) { size_ -= n; }
+
+  T data_[2*Size];
+  int begin_ = 0;
+  int size_ = 0;
+};
+
+/**
+ * HistoryWindow
+ *
+ * An OdeSolution that keeps only the last Size points of a trajectory
+ * (time, point and derivative) in ring buffers of fixed memory.
+ * Adding a point to a full window evicts the oldest one,
+ * which is handed to a SolutionSink as an accepted point.
+ *
+ * The points in the window are contiguous,
+ * so multistep methods can read their history through x.data().
+ */
+template <int N, int Size>
+class HistoryWindow {
+ public:
+  static_assert(Size > 0, "A HistoryWindow must keep at least one point");
+
+  static constexpr int kDim = N;
+  static constexpr int kSize = Size;
+  static constexpr bool kStoresDerivatives = true;
+
+  inline size_t size() const { return t.size(); }
+  inline bool empty() const { return t.size() == 0; }
+  inline bool full() const { return t.size() == Size; }
+  inline bool containsDerivatives() const { return true; }
+
+  inline void addPoint(double t, const Vectord<N>& x, const Vectord<N>& dv) {
+    DiscardSink sink;
+    addPoint(t, x, dv, sink);
+  }
+
+  /**
+   * Adds a point, handing the evicted one to the sink if the window is full.
+   */
+  template <SolutionSink<N> Sink>
+  inline void addPoint(double t, const Vectord<N>& x, const Vectord<N>& dv,
+      Sink& sink) {
+    if (full()) {
+      sink.onPointAccepted(this->t.front(), this->x.front());
+    }
+    this->t.push(t);
+    this->x.push(x);
+    this->dv.push(dv);
+  }
+
+  /**
+   * Removes the last n points.
+   * Points that were already evicted are not recovered.
+   */
+  inline void popBack(int n) {
+    t.pop(n);
+    x.pop(n);
+    dv.pop(n);
+  }
+
+  /**
+   * Hands every point in the window to the sink and empties it.
+   */
+  template <SolutionSink<N> Sink>
+  inline void drain(Sink& sink) {
+    for (size_t i = 0; i < size(); ++i) {
+      sink.onPointAccepted(t[i], x[i]);
+    }
+    popBack(size());
+  }
+
+  RingColumn<double, Size> t;
+  RingColumn<Vectord<N>, Size> x;
+  RingColumn<Vectord<N>, Size> dv;
+};
+
+/**
+ * A HistoryWindow with exactly the points a multistep method needs.
+ */
+template <typename Met, int N>
+using MethodHistoryWindow = HistoryWindow<N, Met::kNeededSteps + 1>;
+
+template <int Size, InitialValueProblem Ivp>
+HistoryWindow<Ivp::Dv::kDim, Size> HistoryWindowFromIvp(Ivp ivp) {
+  HistoryWindow<Ivp::Dv::kDim, Size> window;
+  window.addPoint(ivp.t0(), ivp.x0(), typename Ivp::Dv()(ivp.t0(), ivp.x0()));
+  return window;
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SOLUTIONS_HISTORY_WINDOW_HPP_
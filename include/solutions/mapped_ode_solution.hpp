@@ -0,0 +1,335 @@
+#ifndef INCLUDE_SOLUTIONS_MAPPED_ODE_SOLUTION_HPP_
+#define INCLUDE_SOLUTIONS_MAPPED_ODE_SOLUTION_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include "initial_value_problem.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Header of the files used by MappedOdeSolution.
+ *
+ * The file is the 64 byte header followed by one record per point.
+ * Each record holds 1 + 2*kDim doubles: t, x[0..kDim) and dv[0..kDim),
+ * so the record of point i starts at byte 64 + 8*i*(1 + 2*kDim).
+ * All values are stored in the byte order of the machine that wrote them.
+ * The file may contain room for more records than points.
+ */
+struct MappedOdeSolutionHeader {
+  static constexpr char kMagic[8] = {'O', 'D', 'E', 'L', 'I', 'B', 'M', 'S'};
+  static constexpr uint32_t kVersion = 1;
+  // Set when some point was added without its derivative
+  static constexpr uint64_t kMissingDerivatives = 1;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t dim;
+  uint64_t size;      // number of points
+  uint64_t capacity;  // number of records the file has room for
+  uint64_t flags;
+  uint64_t reserved[3];
+};
+
+static_assert(sizeof(MappedOdeSolutionHeader) == 64);
+
+/**
+ * MappedOdeSolution
+ *
+ * An OdeSolution stored in a memory-mapped file,
+ * for trajectories that do not fit in memory.
+ * The file grows in extents of a fixed number of bytes
+ * and can be reopened by a later process without parsing,
+ * since its layout is that of MappedOdeSolutionHeader.
+ *
+ * The solution is movable but not copyable.
+ * Errors opening or growing the file are logged to the standard error
+ * output and reported through the return value of create, open,
+ * reserve, resize and addPoint, which the solvers check.
+ * A failed growth keeps the points already stored.
+ * The points of a mapped solution are not contiguous,
+ * so it cannot be used with the multistep solvers.
+ */
+template <int N>
+class MappedOdeSolution {
+ public:
+  static constexpr int kDim = N;
+  static constexpr bool kStoresDerivatives = true;
+  static constexpr size_t kRecordDoubles = 1 + 2*N;
+  static constexpr size_t kRecordBytes = kRecordDoubles*sizeof(double);
+  static constexpr size_t kHeaderBytes = sizeof(MappedOdeSolutionHeader);
+  static constexpr size_t kDefaultExtentBytes = size_t(1) << 26;
+
+  using Row = Eigen::Map<Vectord<N>, Eigen::Unaligned>;
+  using ConstRow = Eigen::Map<const Vectord<N>, Eigen::Unaligned>;
+
+  class TimeColumn {
+   public:
+    inline double& operator[](size_t i) { return *sol_->record(i); }
+    inline double operator[](size_t i) const { return *sol_->record(i); }
+    inline double& back() { return (*this)[sol_->size()-1]; }
+    inline double back() const { return (*this)[sol_->size()-1]; }
+    inline size_t size() const { return sol_->size(); }
+
+   private:
+    friend class MappedOdeSolution;
+    explicit TimeColumn(MappedOdeSolution* sol) : sol_(sol) {}
+    MappedOdeSolution* sol_;
+  };
+
+  class PointColumn {
+   public:
+    inline Row operator[](size_t i) { return Row(sol_->record(i) + offset_); }
+    inline ConstRow operator[](size_t i) const {
+      return ConstRow(sol_->record(i) + offset_);
+    }
+    inline Row back() { return (*this)[sol_->size()-1]; }
+    inline ConstRow back() const { return (*this)[sol_->size()-1]; }
+    inline size_t size() const { return sol_->size(); }
+
+   private:
+    friend class MappedOdeSolution;
+    PointColumn(MappedOdeSolution* sol, int offset)
+      : sol_(sol), offset_(offset) {}
+    MappedOdeSolution* sol_;
+    int offset_;
+  };
+
+  explicit MappedOdeSolution(size_t extentBytes = kDefaultExtentBytes)
+    : t(this), x(this, 1), dv(this, 1 + N),
+      extent_(std::max<size_t>(extentBytes/kRecordBytes, 1)) {}
+
+  MappedOdeSolution(const MappedOdeSolution&) = delete;
+  MappedOdeSolution& operator=(const MappedOdeSolution&) = delete;
+
+  MappedOdeSolution(MappedOdeSolution&& other)
+    : MappedOdeSolution(other.extent_*kRecordBytes) {
+    *this = std::move(other);
+  }
+
+  MappedOdeSolution& operator=(MappedOdeSolution&& other) {
+    std::swap(fd_, other.fd_);
+    std::swap(map_, other.map_);
+    std::swap(mapBytes_, other.mapBytes_);
+    std::swap(extent_, other.extent_);
+    std::swap(writable_, other.writable_);
+    return *this;
+  }
+
+  ~MappedOdeSolution() { close(); }
+
+  /**
+   * Creates (or truncates) the file at path and maps it.
+   */
+  bool create(const std::string& path) {
+    close();
+    writable_ = true;
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+      std::cerr << "MappedOdeSolution: cannot create " << path << std::endl;
+      return false;
+    }
+    if (!map(0)) {
+      return false;
+    }
+    MappedOdeSolutionHeader& head = header();
+    std::memcpy(head.magic, MappedOdeSolutionHeader::kMagic, 8);
+    head.version = MappedOdeSolutionHeader::kVersion;
+    head.dim = N;
+    head.size = 0;
+    head.capacity = 0;
+    head.flags = 0;
+    return reserve(extent_);
+  }
+
+  /**
+   * Maps an existing file, which may have been written by another process,
+   * to read it and append to it.
+   */
+  inline bool open(const std::string& path) { return open(path, true); }
+
+  /**
+   * Maps an existing file only to read it, so that it may be read-only.
+   * The file is never written nor trimmed, and the solution cannot grow.
+   */
+  inline bool openReadOnly(const std::string& path) {
+    return open(path, false);
+  }
+
+  /**
+   * Trims the file to the points it contains, unless it was opened
+   * read-only, and unmaps it.
+   */
+  void close() {
+    if (map_ != nullptr) {
+      size_t bytes = kHeaderBytes + size()*kRecordBytes;
+      if (writable_) {
+        header().capacity = size();
+      }
+      munmap(map_, mapBytes_);
+      if (writable_ && ftruncate(fd_, bytes) != 0) {
+        std::cerr << "MappedOdeSolution: cannot trim the file" << std::endl;
+      }
+      map_ = nullptr;
+      mapBytes_ = 0;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  inline bool isOpen() const { return map_ != nullptr; }
+  inline size_t size() const { return map_? header().size : 0; }
+  inline bool empty() const { return size() == 0; }
+  inline bool containsDerivatives() const {
+    return map_ &&
+        !(header().flags & MappedOdeSolutionHeader::kMissingDerivatives);
+  }
+  inline size_t capacity() const { return map_? header().capacity : 0; }
+
+  /**
+   * Grows the file, by whole extents, to hold at least size points.
+   * Fails if the file was opened read-only.
+   */
+  bool reserve(size_t size) {
+    if (!writable_) {
+      std::cerr << "MappedOdeSolution: the file was opened read-only"
+          << std::endl;
+      return false;
+    }
+    if (capacity() >= size) {
+      return true;
+    }
+    size_t extents = (size - capacity() + extent_ - 1)/extent_;
+    size_t capacity = this->capacity() + extents*extent_;
+    size_t bytes = kHeaderBytes + capacity*kRecordBytes;
+    if (ftruncate(fd_, bytes) != 0 || !map(bytes)) {
+      std::cerr << "MappedOdeSolution: cannot grow the file to " << bytes
+          << " bytes" << std::endl;
+      return false;
+    }
+    header().capacity = capacity;
+    return true;
+  }
+
+  inline bool resize(size_t size) {
+    if (!reserve(size)) {
+      return false;
+    }
+    header().size = size;
+    return true;
+  }
+
+  inline bool addPoint(double t, const Vectord<N>& x) {
+    if (!addPoint(t, x, Vectord<N>::Zero())) {
+      return false;
+    }
+    header().flags |= MappedOdeSolutionHeader::kMissingDerivatives;
+    return true;
+  }
+
+  inline bool addPoint(double t, const Vectord<N>& x, const Vectord<N>& dv) {
+    size_t i = size();
+    if (!reserve(i+1)) {
+      return false;
+    }
+    double* rec = record(i);
+    rec[0] = t;
+    Row(rec + 1) = x;
+    Row(rec + 1 + N) = dv;
+    header().size = i+1;
+    return true;
+  }
+
+  TimeColumn t;
+  PointColumn x;
+  PointColumn dv;
+
+ private:
+  inline MappedOdeSolutionHeader& header() const {
+    return *static_cast<MappedOdeSolutionHeader*>(map_);
+  }
+
+  inline double* record(size_t i) const {
+    return reinterpret_cast<double*>(static_cast<char*>(map_) + kHeaderBytes)
+        + i*kRecordDoubles;
+  }
+
+  bool open(const std::string& path, bool writable) {
+    close();
+    writable_ = writable;
+    fd_ = ::open(path.c_str(), writable? O_RDWR : O_RDONLY);
+    struct stat st;
+    if (fd_ < 0 || fstat(fd_, &st) != 0) {
+      std::cerr << "MappedOdeSolution: cannot open " << path << std::endl;
+      close();
+      return false;
+    }
+    if (static_cast<size_t>(st.st_size) < kHeaderBytes || !map(st.st_size)) {
+      std::cerr << "MappedOdeSolution: " << path << " is too small"
+          << std::endl;
+      close();
+      return false;
+    }
+    const MappedOdeSolutionHeader& head = header();
+    if (std::memcmp(head.magic, MappedOdeSolutionHeader::kMagic, 8) != 0
+        || head.version != MappedOdeSolutionHeader::kVersion
+        || head.dim != N) {
+      std::cerr << "MappedOdeSolution: " << path
+          << " is not a solution of dimension " << N << std::endl;
+      close();
+      return false;
+    }
+    // Divided instead of multiplied, so that a huge capacity cannot wrap
+    size_t records = (mapBytes_ - kHeaderBytes)/kRecordBytes;
+    if (head.size > head.capacity || head.capacity > records) {
+      std::cerr << "MappedOdeSolution: " << path << " is corrupt, it claims "
+          << head.size << " points and room for " << head.capacity
+          << " but holds " << records << std::endl;
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  // (Re)maps the first bytes of the file, which must already exist
+  // unless it is writable. If it fails, the previous mapping is kept.
+  bool map(size_t bytes) {
+    bytes = std::max(bytes, kHeaderBytes);
+    if (map_ == nullptr && writable_ && ftruncate(fd_,
+        std::max<off_t>(lseek(fd_, 0, SEEK_END), bytes)) != 0) {
+      return false;
+    }
+    int prot = writable_? PROT_READ | PROT_WRITE : PROT_READ;
+    void* map = mmap(nullptr, bytes, prot, MAP_SHARED, fd_, 0);
+    if (map == MAP_FAILED) {
+      return false;
+    }
+    if (map_ != nullptr) {
+      munmap(map_, mapBytes_);
+    }
+    map_ = map;
+    mapBytes_ = bytes;
+    return true;
+  }
+
+  int fd_ = -1;
+  void* map_ = nullptr;
+  size_t mapBytes_ = 0;
+  size_t extent_;  // in points
+  bool writable_ = true;
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SOLUTIONS_MAPPED_ODE_SOLUTION_HPP_
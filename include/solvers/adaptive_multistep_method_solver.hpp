@@ -6,15 +6,19 @@
 #include "methods/interfaces/adaptive_multistep_method.hpp"
 #include "methods/interfaces/plain_method.hpp"
 #include "ode_solution.hpp"
+#include "solution_sink.hpp"
+#include "solutions/history_window.hpp"
+#include "solvers/initial_step_size.hpp"
 #include "solvers/types.hpp"
 #include "solvers/plain_method_solver.hpp"
+#include "solvers/step_size_controllers.hpp"
 
 namespace odelib {
 
 template <OdeSolution Sol>
 bool SuitedForAdaptiveMultistepMethod(const Sol& sol, const SizeArgs& args,
     int steps) {
-  if (static_cast<int>(sol.size()) < steps + 1) {
+  if (sol.size() < static_cast<size_t>(steps) + 1) {
     std::cerr << "AdaptiveMultistepMethod: you must provide a solution with "
         << steps << " steps!" << std::endl;
     return false;
@@ -37,18 +41,22 @@ bool SuitedForAdaptiveMultistepMethod(const Sol& sol, const SizeArgs& args,
 }
 
 template <IvpDerivative D, AdaptiveMultistepMethod Met, PlainMethod Init,
-    OdeSolution Sol>
+    OdeSolutionWithDerivatives Sol,
+    StepSizeController Ctrl = PredictivePIController>
 SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const Init& init,
-    const D& f, const SizeArgs& args, bool recompute = true) {
+    const D& f, const SizeArgs& args, bool recompute = true,
+    Ctrl ctrl = Ctrl()) {
   constexpr int nsteps = met.kNeededSteps;
   if (!SuitedForAdaptiveMultistepMethod(sol, args, recompute? 0 : nsteps)) {
     return SolverResult::kViolatedPrecondition;
   }
   double tol = args.tolerance;
+  constexpr int k = ErrorOrder<Met>();
   auto& t = sol.t;
   auto& x = sol.x;
   auto& dv = sol.dv;
-  double h = recompute? std::sqrt(args.minStepAllowed*args.maxStepAllowed) :
+  double h = recompute?
+      InitialStepSize(f, t.back(), x.back(), dv.back(), k, args) :
       t[t.size()-1] - t[t.size()-2];
 
   while (t.back() < args.maxTime) {
@@ -64,9 +72,11 @@ SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const Init& init,
       dv.push_back(f(t.back(), y));
       recompute = false;
       // If the error is not really small, keep the last step size
+      double proposed = ctrl.accepted(step, err/(step*tol), k);
       if (err > step*tol*0.1) {
         h = step;
       } else {
+        h = proposed;
         recompute = true;
       }
     } else {
@@ -76,6 +86,7 @@ SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const Init& init,
         x.resize(x.size()-nsteps);
         dv.resize(dv.size()-nsteps);
       }
+      h = ctrl.rejected(step, err/(step*tol), k);
       recompute = true;
     }
     if (h < args.minStepAllowed) {
@@ -91,30 +102,100 @@ SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const Init& init,
   return SolverResult::kOk;
 }
 
+/**
+ * Extends a HistoryWindow past the maximum time.
+ * Only the points the method needs are kept,
+ * and the older ones are handed to the sink as accepted points,
+ * so memory use does not depend on the length of the integration.
+ * The sink is not finished, since the window still holds the last points:
+ * drain the window into it before calling its onFinished.
+ */
 template <IvpDerivative D, AdaptiveMultistepMethod Met, PlainMethod Init,
-    OdeSolution Sol, CrossFunction StopCond>
+    int N, int Size, SolutionSink<N> Sink = DiscardSink,
+    StepSizeController Ctrl = PredictivePIController>
+SolverResult ExtendPastMaxTime(HistoryWindow<N, Size>& window, const Met& met,
+    const Init& init, const D& f, const SizeArgs& args, bool recompute = true,
+    Sink&& sink = Sink(), Ctrl ctrl = Ctrl()) {
+  constexpr int nsteps = met.kNeededSteps;
+  static_assert(Size >= nsteps + 1, "The window cannot hold the history");
+  if (!SuitedForAdaptiveMultistepMethod(window, args,
+      recompute? 0 : nsteps)) {
+    return SolverResult::kViolatedPrecondition;
+  }
+  double tol = args.tolerance;
+  constexpr int k = ErrorOrder<Met>();
+  const auto& t = window.t;
+  double h = recompute? InitialStepSize(f, t.back(), window.x.back(),
+      window.dv.back(), k, args) : t[t.size()-1] - t[t.size()-2];
+
+  while (t.back() < args.maxTime) {
+    if (recompute) {
+      AppendNSteps(window, init, f, h, nsteps, sink);
+    }
+    double step = h;
+    size_t first = window.size() - (nsteps+1);
+    auto [y, err] = met.step(f, t.back(), window.x.data() + first, h,
+        window.dv.data() + first, tol);
+    if (err < step*tol) {
+      double next = t.back() + step;
+      window.addPoint(next, y, f(next, y), sink);
+      recompute = false;
+      // If the error is not really small, keep the last step size
+      double proposed = ctrl.accepted(step, err/(step*tol), k);
+      if (err > step*tol*0.1) {
+        h = step;
+      } else {
+        h = proposed;
+        recompute = true;
+      }
+    } else {
+      if (recompute) {
+        // Remove the extra steps on failure
+        window.popBack(nsteps);
+      }
+      sink.onStepRejected(t.back(), step);
+      h = ctrl.rejected(step, err/(step*tol), k);
+      recompute = true;
+    }
+    if (h < args.minStepAllowed) {
+      if (step > args.minStepAllowed) {
+        h = args.minStepAllowed;
+      } else {
+        return SolverResult::kStepWentBelowMin;
+      }
+    }
+    h = std::min(h, args.maxStepAllowed);
+  }
+  return SolverResult::kOk;
+}
+
+template <IvpDerivative D, AdaptiveMultistepMethod Met, PlainMethod Init,
+    OdeSolutionWithDerivatives Sol, CrossFunction StopCond,
+    StepSizeController Ctrl = PredictivePIController>
 SolverResult ExtendPastZero(Sol& sol, const Met& met, const Init& init,
     const D& f, const SizeArgs& args, const StopCond& cross,
-    bool recompute = true) {
+    bool recompute = true, Ctrl ctrl = Ctrl()) {
   constexpr int nsteps = met.kNeededSteps;
   if (!SuitedForAdaptiveMultistepMethod(sol, args, recompute? 0 : nsteps)) {
     return SolverResult::kViolatedPrecondition;
   }
 
   double tol = args.tolerance;
-  auto& t = sol.t();
-  auto& x = sol.x();
-  auto& dv = sol.dv();
-  double h = recompute? std::sqrt(args.minStepAllowed*args.maxStepAllowed) :
+  constexpr int k = ErrorOrder<Met>();
+  auto& t = sol.t;
+  auto& x = sol.x;
+  auto& dv = sol.dv;
+  double h = recompute?
+      InitialStepSize(f, t.back(), x.back(), dv.back(), k, args) :
       t[t.size()-1] - t[t.size()-2];
   double sgn0 = cross(t.back(), x.back());
 
   while (t.back() < args.maxTime) {
     if (recompute) {
-      stepN(sol, f, init, h, nsteps);
+      AppendNSteps(sol, init, f, h, nsteps);
     }
     double step = h;
-    auto [y, err] = met.step(t.back(), &*(x.end()-(nsteps+1)), h,
+    auto [y, err] = met.step(f, t.back(), &*(x.end()-(nsteps+1)), h,
         &*(dv.end()-(nsteps+1)), tol);
 
     if (err < step*tol) {
@@ -141,9 +222,11 @@ SolverResult ExtendPastZero(Sol& sol, const Met& met, const Init& init,
       }
       sgn0 = sgn1;
       // If the error is not really small, keep the last step size
+      double proposed = ctrl.accepted(step, err/(step*tol), k);
       if (err > step*tol*0.1) {
         h = step;
       } else {
+        h = proposed;
         recompute = true;
       }
     } else {
@@ -153,6 +236,7 @@ SolverResult ExtendPastZero(Sol& sol, const Met& met, const Init& init,
         x.resize(x.size()-nsteps);
         dv.resize(dv.size()-nsteps);
       }
+      h = ctrl.rejected(step, err/(step*tol), k);
       recompute = true;
     }
     if (h < args.minStepAllowed) {
@@ -3,7 +3,10 @@
 
 #include <iostream>
 #include <utility>
+#include "initial_value_problem.hpp"
+#include "methods/interfaces/plain_method.hpp"
 #include "methods/plain_rk_methods.hpp"
+#include "ode_solution.hpp"
 
 namespace odelib {
 
@@ -99,7 +102,7 @@ std::pair<double, Vectord<Sol::kDim>> CrossPoint(const F& cross, const D& f,
 
 template <CrossFunction F, IvpDerivative D, OdeSolution Sol,
     PlainMethod Method>
-bool AddCrossPoint(const F& cross, const D& f, const Sol& sol, double tol,
+bool AddCrossPoint(const F& cross, const D& f, Sol& sol, double tol,
     const Method& met) {
   size_t sz = sol.size();
   if (sz < 2) {
@@ -109,12 +112,11 @@ bool AddCrossPoint(const F& cross, const D& f, const Sol& sol, double tol,
   }
   auto [t, x] = CrossPoint(cross, f, sol.t[sz-2], sol.x[sz-2], sol.t[sz-1],
       tol, met);
-  sol.addPoint(t, x);
-  return true;
+  return AddSolutionPoint(sol, t, x);
 }
 
 template <int Order, CrossFunction F, IvpDerivative D, OdeSolution Sol>
-bool AddCrossPoint(const F& cross, const D& f, const Sol& sol, double tol) {
+bool AddCrossPoint(const F& cross, const D& f, Sol& sol, double tol) {
   size_t sz = sol.size();
   if (sz < 2) {
     std::cerr << "CrossPoint: The solution contains less than 2 points"
@@ -123,8 +125,7 @@ bool AddCrossPoint(const F& cross, const D& f, const Sol& sol, double tol) {
   }
   auto [t, x] = CrossPoint<Order>(cross, f, sol.t[sz-2], sol.x[sz-2],
       sol.t[sz-1], tol);
-  sol.addPoint(t, x);
-  return true;
+  return AddSolutionPoint(sol, t, x);
 }
 
 }  // namespace odelib
@@ -0,0 +1,42 @@
+#ifndef INCLUDE_SOLVERS_INITIAL_STEP_SIZE_HPP_
+#define INCLUDE_SOLVERS_INITIAL_STEP_SIZE_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include "initial_value_problem.hpp"
+#include "solvers/types.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Chooses the size of the first step of an adaptive solver from (t, x),
+ * where the derivative is dv, and the order k in h of the ratio
+ * of its error to the error allowed (see RatioOrder),
+ * with the algorithm of Hairer, Nørsett and Wanner.
+ *
+ * An Euler step of size h0 = 0.01 |x|/|dv| estimates the second
+ * derivative with one more evaluation, and the step is the one whose
+ * ratio, taken as the largest derivative times h^k/tol,
+ * is a hundredth.
+ * It is not allowed to be more than 100 times h0,
+ * and it is kept between the minimum and maximum steps allowed.
+ */
+template <IvpDerivative D>
+double InitialStepSize(const D& f, double t, const Vectord<D::kDim>& x,
+    const Vectord<D::kDim>& dv, int k, const SizeArgs& args) {
+  double d0 = x.norm();
+  double d1 = dv.norm();
+  double h0 = d0 < 1e-5 || d1 < 1e-5? 1e-6 : 0.01*d0/d1;
+  h0 = std::max(args.minStepAllowed, std::min(h0, args.maxStepAllowed));
+  double d2 = (f(t + h0, x + h0*dv) - dv).norm()/h0;
+  double d = std::max(d1, d2);
+  double h1 = d <= 1e-15? std::max(1e-6, h0*1e-3) :
+      std::pow(0.01*args.tolerance/d, 1.0/k);
+  double h = std::min(100*h0, h1);
+  return std::max(args.minStepAllowed, std::min(h, args.maxStepAllowed));
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SOLVERS_INITIAL_STEP_SIZE_HPP_
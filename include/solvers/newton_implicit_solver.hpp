@@ -6,6 +6,9 @@
 #include "methods/interfaces/plain_implicit_method.hpp"
 #include "methods/interfaces/backward_differentiation_formula.hpp"
 #include "ode_solution.hpp"
+#include "solution_sink.hpp"
+#include "solutions/history_window.hpp"
+#include "solvers/cross_function.hpp"
 #include "solvers/types.hpp"
 
 namespace odelib {
@@ -30,13 +33,7 @@ struct Newton1d {
   }
 };
 
-template <OdeSolution Sol>
-bool SuitedForPlainImplicitMethod(const Sol& sol, const SizeArgs& args) {
-  if (sol.empty()) {
-    std::cerr << "PlainImplicitMethod: you must provide a non-empty solution"
-        << std::endl;
-    return false;
-  }
+inline bool SuitedForPlainImplicitMethod(const SizeArgs& args) {
   if (args.fixedStepSize <= 0) {
     std::cerr << "PlainImplicitMethod: fixedStepSize must be > 0!" << std::endl;
     return false;
@@ -48,16 +45,28 @@ bool SuitedForPlainImplicitMethod(const Sol& sol, const SizeArgs& args) {
   return true;
 }
 
+template <OdeSolution Sol>
+bool SuitedForPlainImplicitMethod(const Sol& sol, const SizeArgs& args) {
+  if (sol.empty()) {
+    std::cerr << "PlainImplicitMethod: you must provide a non-empty solution"
+        << std::endl;
+    return false;
+  }
+  return SuitedForPlainImplicitMethod(args);
+}
+
 template <PlainImplicitMethod Met, IvpDerivative D, OdeSolution Sol>
 SolverResult NewtonAppendNSteps(Sol& sol, const Met& met, const D& f, double h,
-    double tol, int n) {
+    double tol, size_t n) {
   Newton1d solver;
   double t = sol.t.back();
   auto& x = sol.x;
-  int zero = sol.size();
+  size_t zero = sol.size();
   n += zero;
-  sol.resize(n);
-  for (int i = zero; i < n; ++i) {
+  if (!ResizeSolution(sol, n)) {
+    return SolverResult::kFailedToGrowSolution;
+  }
+  for (size_t i = zero; i < n; ++i) {
     auto [y, converged] =
         solver.solve(met.equation(f, t, x[i-1], h), x[i-1], tol);
     if (!converged) {
@@ -65,7 +74,9 @@ SolverResult NewtonAppendNSteps(Sol& sol, const Met& met, const D& f, double h,
     }
     sol.x[i] = y;
     sol.t[i] = t += h;
-    sol.dv[i] = f(sol.t[i], sol.x[i]);
+    if constexpr (Sol::kStoresDerivatives) {
+      sol.dv[i] = f(sol.t[i], sol.x[i]);
+    }
   }
   return SolverResult::kOk;
 }
@@ -77,7 +88,7 @@ SolverResult NewtonExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
     return SolverResult::kViolatedPrecondition;
   }
   double h = args.fixedStepSize;
-  int iter = std::max(std::ceil((args.maxTime - sol.t.back())/h), 0.0);
+  size_t iter = std::max(std::ceil((args.maxTime - sol.t.back())/h), 0.0);
   return NewtonAppendNSteps(sol, met, f, h, args.tolerance, iter);
 }
 
@@ -100,7 +111,9 @@ SolverResult NewtonExtendPastZero(Sol& sol, const Met& met, const D& f,
       return SolverResult::kFailedToSolveImplicitEq;
     }
     t += h;
-    sol.addPoint(t, y);
+    if (!AddSolutionPoint(sol, t, y)) {
+      return SolverResult::kFailedToGrowSolution;
+    }
     double sgn1 = cross(t, sol.x.back());
     if (sgn0*sgn1 < 0) {
       return SolverResult::kOk;
@@ -110,9 +123,78 @@ SolverResult NewtonExtendPastZero(Sol& sol, const Met& met, const D& f,
   return SolverResult::kExhaustedInterval;
 }
 
+/**
+ * Integrates from (t, x) past the maximum time,
+ * handing every new point to the sink instead of storing it.
+ * Only the current point is kept, so memory use is constant.
+ */
+template <IvpDerivative D, PlainImplicitMethod Met,
+    SolutionSink<D::kDim> Sink>
+SolverResult NewtonStreamPastMaxTime(double t, Vectord<D::kDim> x,
+    const Met& met, const D& f, const SizeArgs& args, Sink&& sink) {
+  if (!SuitedForPlainImplicitMethod(args)) {
+    sink.onFinished(SolverResult::kViolatedPrecondition);
+    return SolverResult::kViolatedPrecondition;
+  }
+  Newton1d solver;
+  double h = args.fixedStepSize;
+  size_t iter = std::max(std::ceil((args.maxTime - t)/h), 0.0);
+  for (size_t i = 0; i < iter; ++i) {
+    auto [y, converged] =
+        solver.solve(met.equation(f, t, x, h), x, args.tolerance);
+    if (!converged) {
+      sink.onFinished(SolverResult::kFailedToSolveImplicitEq);
+      return SolverResult::kFailedToSolveImplicitEq;
+    }
+    x = y;
+    t += h;
+    sink.onPointAccepted(t, x);
+  }
+  sink.onFinished(SolverResult::kOk);
+  return SolverResult::kOk;
+}
+
+/**
+ * Integrates from (t, x) until the cross function changes sign,
+ * handing every new point to the sink instead of storing it.
+ * The last point handed to the sink is the first one past the zero.
+ */
+template <IvpDerivative D, PlainImplicitMethod Met,
+    SolutionSink<D::kDim> Sink, CrossFunction Cross>
+SolverResult NewtonStreamPastZero(double t, Vectord<D::kDim> x,
+    const Met& met, const D& f, const SizeArgs& args, const Cross& cross,
+    Sink&& sink) {
+  if (!SuitedForPlainImplicitMethod(args)) {
+    sink.onFinished(SolverResult::kViolatedPrecondition);
+    return SolverResult::kViolatedPrecondition;
+  }
+  Newton1d solver;
+  double h = args.fixedStepSize;
+  double sgn0 = cross(t, x);
+  while (t < args.maxTime) {
+    auto [y, converged] =
+        solver.solve(met.equation(f, t, x, h), x, args.tolerance);
+    if (!converged) {
+      sink.onFinished(SolverResult::kFailedToSolveImplicitEq);
+      return SolverResult::kFailedToSolveImplicitEq;
+    }
+    x = y;
+    t += h;
+    sink.onPointAccepted(t, x);
+    double sgn1 = cross(t, x);
+    if (sgn0*sgn1 < 0) {
+      sink.onFinished(SolverResult::kOk);
+      return SolverResult::kOk;
+    }
+    sgn0 = sgn1;
+  }
+  sink.onFinished(SolverResult::kExhaustedInterval);
+  return SolverResult::kExhaustedInterval;
+}
+
 template <OdeSolution Sol>
 bool SuitedForBdf(const Sol& sol, const SizeArgs& args, int nsteps) {
-  if ((int) sol.size() < nsteps + 1) {
+  if (sol.size() < static_cast<size_t>(nsteps) + 1) {
     std::cerr << "Bdf: you must provide a solution with " << nsteps
         << " steps!" << std::endl;
     return false;
@@ -140,10 +222,12 @@ SolverResult NewtonExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
   double tol = args.tolerance;
   auto& t = sol.t;
   auto& x = sol.x;
-  int zero = sol.size();
-  int iter = zero + std::max(std::ceil((args.maxTime - t.back())/h), 0.0);
-  sol.resize(iter);
-  for (int i = zero; i < iter; ++i) {
+  size_t zero = sol.size();
+  size_t iter = zero + std::max(std::ceil((args.maxTime - t.back())/h), 0.0);
+  if (!ResizeSolution(sol, iter)) {
+    return SolverResult::kFailedToGrowSolution;
+  }
+  for (size_t i = zero; i < iter; ++i) {
     auto [y, converged] =
         solver.solve(met.equation(f, t[i-1], &x[i-1]-nsteps, h), x[i-1], tol);
     if (!converged) {
@@ -151,6 +235,42 @@ SolverResult NewtonExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
     }
     x[i] = y;
     t[i] = t[i-1] + h;
+    if constexpr (Sol::kStoresDerivatives) {
+      sol.dv[i] = f(t[i], x[i]);
+    }
+  }
+  return SolverResult::kOk;
+}
+
+/**
+ * Extends a HistoryWindow past the maximum time with a BDF.
+ * Only the points the method needs are kept,
+ * and the older ones are handed to the sink as accepted points,
+ * so memory use does not depend on the length of the integration.
+ * The sink is not finished, since the window still holds the last points:
+ * drain the window into it before calling its onFinished.
+ */
+template <IvpDerivative D, BackwardDifferentiationFormula Met, int N,
+    int Size, SolutionSink<N> Sink = DiscardSink>
+SolverResult NewtonExtendPastMaxTime(HistoryWindow<N, Size>& window,
+    const Met& met, const D& f, const SizeArgs& args, Sink&& sink = Sink()) {
+  constexpr int nsteps = met.kNeededSteps;
+  static_assert(Size >= nsteps + 1, "The window cannot hold the history");
+  if (!SuitedForBdf(window, args, nsteps)) {
+    return SolverResult::kViolatedPrecondition;
+  }
+  Newton1d solver;
+  double h = args.fixedStepSize;
+  size_t iter = std::max(std::ceil((args.maxTime - window.t.back())/h), 0.0);
+  for (size_t i = 0; i < iter; ++i) {
+    double t = window.t.back();
+    size_t first = window.size() - (nsteps+1);
+    auto [y, converged] = solver.solve(met.equation(f, t,
+        window.x.data() + first, h), window.x.back(), args.tolerance);
+    if (!converged) {
+      return SolverResult::kFailedToSolveImplicitEq;
+    }
+    window.addPoint(t + h, y, f(t + h, y), sink);
   }
   return SolverResult::kOk;
 }
@@ -176,7 +296,9 @@ SolverResult NewtonExtendPastZero(Sol& sol, const Met& met, const D& f,
       return SolverResult::kFailedToSolveImplicitEq;
     }
     t += h;
-    sol.addPoint(t, y);
+    if (!AddSolutionPoint(sol, t, y)) {
+      return SolverResult::kFailedToGrowSolution;
+    }
     double sgn1 = cross(t, sol.x.back());
     if (sgn0*sgn1 < 0) {
       return SolverResult::kOk;
@@ -0,0 +1,438 @@
+#ifndef INCLUDE_SOLVERS_NORDSIECK_METHOD_SOLVER_HPP_
+#define INCLUDE_SOLVERS_NORDSIECK_METHOD_SOLVER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "initial_value_problem.hpp"
+#include "methods/interfaces/nordsieck_method.hpp"
+#include "ode_solution.hpp"
+#include "solution_sink.hpp"
+#include "solvers/cross_function.hpp"
+#include "solvers/initial_step_size.hpp"
+#include "solvers/step_size_controllers.hpp"
+#include "solvers/types.hpp"
+
+namespace odelib {
+
+inline bool SuitedForNordsieckMethod(const SizeArgs& args) {
+  if (args.tolerance <= 0) {
+    std::cerr << "NordsieckMethod: tolerance must be > 0!" << std::endl;
+    return false;
+  }
+  if (args.minStepAllowed <= 0) {
+    std::cerr << "NordsieckMethod: minStepAllowed must be > 0!" << std::endl;
+    return false;
+  }
+  if (args.maxStepAllowed <= 0) {
+    std::cerr << "NordsieckMethod: maxStepAllowed must be > 0!" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <OdeSolution Sol>
+bool SuitedForNordsieckMethod(const Sol& sol, const SizeArgs& args) {
+  if (sol.empty()) {
+    std::cerr << "NordsieckMethod: you must provide a non-empty solution"
+        << std::endl;
+    return false;
+  }
+  return SuitedForNordsieckMethod(args);
+}
+
+/**
+ * NordsieckStepper
+ *
+ * Takes the steps of a NordsieckMethod, starting at order 1
+ * with the step of InitialStepSize and choosing the order
+ * and the step size as in Hindmarsh's LSODE.
+ *
+ * After q+1 steps without changes, the local errors of orders
+ * q-1, q and q+1 are estimated from z[q], the last correction e
+ * and its difference with the one before, and the order
+ * that allows the largest step is taken, if it is at least
+ * 10% larger. A rejected step is retried with the orders q-1 or q,
+ * and after three rejections in a row, with order 1
+ * and a step 10 times smaller.
+ * The last step sizes are kept, so that raising the order
+ * fits the next older point (or derivative) exactly,
+ * which the history before the last correction fitted.
+ * Like the adaptive solvers, the step is accepted when the error
+ * is below h*tol, raised to the rounding error of the step,
+ * see AllowedError.
+ */
+template <IvpDerivative D, NordsieckMethod<D> Met>
+class NordsieckStepper {
+ public:
+  static constexpr int N = D::kDim;
+  static constexpr int kMaxOrder = Met::kMaxOrder;
+
+  NordsieckStepper(const D& f, double t, const Vectord<N>& x,
+      const SizeArgs& args)
+    : f_(f), args_(args), t_(t) {
+    Vectord<N> zero = Vectord<N>::Zero(x.size());
+    z_.fill(zero);
+    e_ = zero;
+    d1_ = zero;
+    Vectord<N> dv = f(t, x);
+    h_ = InitialStepSize(f, t, x, dv, 1, args);
+    z_[0] = x;
+    z_[1] = h_*dv;
+  }
+
+  /**
+   * Tries a step of size h() from (t(), x()).
+   * Returns whether it was accepted. Otherwise,
+   * the step size was reduced, but not below minStepAllowed.
+   */
+  bool step() {
+    predict();
+    tol_ = AllowedError<Met>(h_, args_.tolerance, z_[0], z_[0] + z_[1])/h_;
+    std::array<double, kMaxOrder+2> xi = distances();
+    l_ = Met::corrector(q_, xi.data());
+    if (!corrector_.correct(f_, t_ + h_, z_.data(), h_, q_, l_, e_, tol_)) {
+      unpredict();
+      rescale(0.25);
+      wait_ = q_ + 1;
+      return false;
+    }
+    double r = Met::errorCoefficient(q_, xi.data())*e_.norm()/(h_*tol_);
+    if (r >= 1) {
+      unpredict();
+      reject(r);
+      return false;
+    }
+
+    failures_ = 0;
+    for (int j = 0; j <= q_; ++j) {
+      z_[j] += l_[j]*e_;
+    }
+    t_ += h_;
+    std::copy_backward(tau_.begin(), tau_.end()-1, tau_.end());
+    tau_[0] = h_;
+    --wait_;
+    if (wait_ == 1 && q_ < kMaxOrder) {
+      d1_ = derivativeScale()*e_;
+    }
+    if (wait_ <= 0) {
+      adapt(r);
+    }
+    return true;
+  }
+
+  inline double t() const { return t_; }
+
+  inline const Vectord<N>& x() const { return z_[0]; }
+
+  inline double h() const { return h_; }
+
+  inline int order() const { return q_; }
+
+ private:
+  /**
+   * Multiplies the last column by the Pascal triangle,
+   * the Taylor expansion of z to t+h.
+   */
+  void predict() {
+    for (int k = 0; k < q_; ++k) {
+      for (int j = q_; j > k; --j) {
+        z_[j-1] += z_[j];
+      }
+    }
+  }
+
+  void unpredict() {
+    for (int k = q_-1; k >= 0; --k) {
+      for (int j = k+1; j <= q_; ++j) {
+        z_[j-1] -= z_[j];
+      }
+    }
+  }
+
+  void rescale(double eta) {
+    eta = std::max(eta, args_.minStepAllowed/h_);
+    eta = std::min(eta, args_.maxStepAllowed/h_);
+    double factor = 1;
+    for (int j = 1; j <= q_; ++j) {
+      factor *= eta;
+      z_[j] *= factor;
+    }
+    h_ *= eta;
+  }
+
+  /**
+   * The distances from t() to the last points in units of h().
+   */
+  std::array<double, kMaxOrder+2> distances() const {
+    std::array<double, kMaxOrder+2> xi{};
+    for (int i = 1; i <= kMaxOrder+1; ++i) {
+      xi[i] = xi[i-1] + tau_[i-1]/h_;
+    }
+    return xi;
+  }
+
+  /**
+   * q! l[q], the factor that takes the correction
+   * to h^(q+1) x^(q+1) with constant steps.
+   */
+  inline double derivativeScale() const {
+    double factor = l_[q_];
+    for (int i = 2; i <= q_; ++i) {
+      factor *= i;
+    }
+    return factor;
+  }
+
+  /**
+   * The factor of the step size that makes the error of order q
+   * a fraction of the tolerance, given its ratio r to it.
+   */
+  static inline double Eta(double r, double bias, int q) {
+    return 1/(std::pow(bias*r, 1.0/q) + 1e-6);
+  }
+
+  inline double etaDown() const {
+    if (q_ == 1) {
+      return 0;
+    }
+    double factor = Met::errorConstant[q_-1];
+    for (int i = 2; i <= q_; ++i) {
+      factor *= i;
+    }
+    double r = factor*z_[q_].norm()/(h_*tol_);
+    return Eta(r, 1.3, q_-1);
+  }
+
+  void reject(double r) {
+    ++failures_;
+    wait_ = q_ + 1;
+    if (failures_ >= 3) {
+      // The history is not to be trusted, restart from the point
+      q_ = 1;
+      rescale(0.1);
+      z_[1] = h_*f_(t_, z_[0]);
+      return;
+    }
+    double eta = Eta(r, 1.2, q_);
+    double down = etaDown();
+    if (down > eta) {
+      eta = down;
+      lowerOrder();
+    }
+    rescale(std::min(eta, failures_ >= 2? 0.2 : 0.9));
+  }
+
+  void adapt(double r) {
+    double eta = Eta(r, 1.2, q_);
+    double down = etaDown();
+    double up = 0;
+    if (q_ < kMaxOrder) {
+      double r1 = Met::errorConstant[q_+1]
+          * (derivativeScale()*e_ - d1_).norm()/(h_*tol_);
+      up = Eta(r1, 1.4, q_+1);
+    }
+    if (std::max(up, down) > eta) {
+      if (up > down) {
+        eta = up;
+        raiseOrder();
+      } else {
+        eta = down;
+        lowerOrder();
+      }
+    }
+    if (eta < 1.1) {
+      wait_ = 3;
+      return;
+    }
+    rescale(std::min(eta, etaMax_));
+    etaMax_ = 10;
+    wait_ = q_ + 1;
+  }
+
+  /**
+   * Adds the column q+1 so that the history also fits the next older
+   * point (or derivative), the one that the last correction l*e dropped.
+   * It is taken from the correction rather than stored,
+   * since subtracting the points cancels at small steps.
+   */
+  void raiseOrder() {
+    std::array<double, kMaxOrder+2> xi = distances();
+    auto R = Met::raiser(q_, xi.data());
+    double s = -xi[Met::kDerivativeNodes? q_ : q_+1];
+    double dropped = 0;
+    double raised = 0;
+    double power = 1;
+    for (int j = 0; j <= q_+1; ++j) {
+      if (Met::kDerivativeNodes && j == 0) {
+        continue;
+      }
+      double factor = Met::kDerivativeNodes? j*power : power;
+      dropped += factor*l_[j];
+      raised += factor*R[j];
+      power *= s;
+    }
+    Vectord<N> c = -dropped/raised*e_;
+    for (int j = 0; j <= q_; ++j) {
+      z_[j] += R[j]*c;
+    }
+    z_[q_+1] = R[q_+1]*c;
+    ++q_;
+  }
+
+  void lowerOrder() {
+    auto d = Met::lowerer(q_, distances().data());
+    for (int j = 0; j < q_; ++j) {
+      z_[j] -= d[j]*z_[q_];
+    }
+    --q_;
+  }
+
+  const D& f_;
+  const SizeArgs& args_;
+  typename Met::template Corrector<N> corrector_;
+  double t_;
+  double h_;
+  int q_ = 1;
+  // The tolerance per unit step of the last step
+  double tol_ = 0;
+  // One more column for raising the order
+  std::array<Vectord<N>, kMaxOrder+2> z_;
+  typename Met::Coefficients l_{};
+  // The last correction, and h^(q+1) x^(q+1) saved for estimating
+  // the error of order q+1
+  Vectord<N> e_;
+  Vectord<N> d1_;
+  // The last accepted step sizes
+  std::array<double, kMaxOrder+1> tau_{};
+  // Steps left before the order and the step size may change
+  int wait_ = 2;
+  int failures_ = 0;
+  // The first change can make the step much larger,
+  // since it starts with the error of order 1
+  double etaMax_ = 1e4;
+};
+
+/**
+ * Extends the solution past the maximum time
+ * with a NordsieckMethod. See NordsieckStepper.
+ */
+template <IvpDerivative D, NordsieckMethod<D> Met, OdeSolution Sol>
+SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
+    const SizeArgs& args) {
+  if (!SuitedForNordsieckMethod(sol, args)) {
+    return SolverResult::kViolatedPrecondition;
+  }
+  NordsieckStepper<D, Met> stepper(f, sol.t.back(), sol.x.back(), args);
+  while (stepper.t() < args.maxTime) {
+    double step = stepper.h();
+    if (stepper.step()) {
+      if (!AddSolutionPoint(sol, stepper.t(), stepper.x())) {
+        return SolverResult::kFailedToGrowSolution;
+      }
+    } else if (step <= args.minStepAllowed) {
+      return SolverResult::kStepWentBelowMin;
+    }
+  }
+  return SolverResult::kOk;
+}
+
+template <IvpDerivative D, NordsieckMethod<D> Met, OdeSolution Sol,
+    CrossFunction StopCond>
+SolverResult ExtendPastZero(Sol& sol, const Met& met, const D& f,
+    const SizeArgs& args, const StopCond& cross) {
+  if (!SuitedForNordsieckMethod(sol, args)) {
+    return SolverResult::kViolatedPrecondition;
+  }
+  NordsieckStepper<D, Met> stepper(f, sol.t.back(), sol.x.back(), args);
+  double sgn0 = cross(stepper.t(), stepper.x());
+  while (stepper.t() < args.maxTime) {
+    double step = stepper.h();
+    if (stepper.step()) {
+      if (!AddSolutionPoint(sol, stepper.t(), stepper.x())) {
+        return SolverResult::kFailedToGrowSolution;
+      }
+      double sgn1 = cross(stepper.t(), stepper.x());
+      if (sgn0*sgn1 < 0) {
+        return SolverResult::kOk;
+      }
+      sgn0 = sgn1;
+    } else if (step <= args.minStepAllowed) {
+      return SolverResult::kStepWentBelowMin;
+    }
+  }
+  return SolverResult::kExhaustedInterval;
+}
+
+/**
+ * Integrates from (t, x) past the maximum time
+ * with a NordsieckMethod, handing every accepted point
+ * and every rejected step to the sink.
+ */
+template <IvpDerivative D, NordsieckMethod<D> Met,
+    SolutionSink<D::kDim> Sink>
+SolverResult StreamPastMaxTime(double t, const Vectord<D::kDim>& x,
+    const Met& met, const D& f, const SizeArgs& args, Sink&& sink) {
+  if (!SuitedForNordsieckMethod(args)) {
+    sink.onFinished(SolverResult::kViolatedPrecondition);
+    return SolverResult::kViolatedPrecondition;
+  }
+  NordsieckStepper<D, Met> stepper(f, t, x, args);
+  while (stepper.t() < args.maxTime) {
+    double step = stepper.h();
+    if (stepper.step()) {
+      sink.onPointAccepted(stepper.t(), stepper.x());
+    } else {
+      sink.onStepRejected(stepper.t(), step);
+      if (step <= args.minStepAllowed) {
+        sink.onFinished(SolverResult::kStepWentBelowMin);
+        return SolverResult::kStepWentBelowMin;
+      }
+    }
+  }
+  sink.onFinished(SolverResult::kOk);
+  return SolverResult::kOk;
+}
+
+/**
+ * Integrates from (t, x) until the cross function changes sign
+ * with a NordsieckMethod, handing every accepted point
+ * and every rejected step to the sink.
+ * The last point handed to the sink is the first one past the zero.
+ */
+template <IvpDerivative D, NordsieckMethod<D> Met,
+    SolutionSink<D::kDim> Sink, CrossFunction StopCond>
+SolverResult StreamPastZero(double t, const Vectord<D::kDim>& x,
+    const Met& met, const D& f, const SizeArgs& args, const StopCond& cross,
+    Sink&& sink) {
+  if (!SuitedForNordsieckMethod(args)) {
+    sink.onFinished(SolverResult::kViolatedPrecondition);
+    return SolverResult::kViolatedPrecondition;
+  }
+  NordsieckStepper<D, Met> stepper(f, t, x, args);
+  double sgn0 = cross(t, x);
+  while (stepper.t() < args.maxTime) {
+    double step = stepper.h();
+    if (stepper.step()) {
+      sink.onPointAccepted(stepper.t(), stepper.x());
+      double sgn1 = cross(stepper.t(), stepper.x());
+      if (sgn0*sgn1 < 0) {
+        sink.onFinished(SolverResult::kOk);
+        return SolverResult::kOk;
+      }
+      sgn0 = sgn1;
+    } else {
+      sink.onStepRejected(stepper.t(), step);
+      if (step <= args.minStepAllowed) {
+        sink.onFinished(SolverResult::kStepWentBelowMin);
+        return SolverResult::kStepWentBelowMin;
+      }
+    }
+  }
+  sink.onFinished(SolverResult::kExhaustedInterval);
+  return SolverResult::kExhaustedInterval;
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SOLVERS_NORDSIECK_METHOD_SOLVER_HPP_
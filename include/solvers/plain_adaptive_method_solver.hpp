@@ -2,20 +2,19 @@
 #define INCLUDE_SOLVERS_PLAIN_ADAPTIVE_METHOD_SOLVER_HPP_
 
 #include <algorithm>
+#include <utility>
 #include "initial_value_problem.hpp"
 #include "methods/interfaces/plain_adaptive_method.hpp"
 #include "ode_solution.hpp"
+#include "solution_sink.hpp"
+#include "solvers/cross_function.hpp"
+#include "solvers/initial_step_size.hpp"
+#include "solvers/step_size_controllers.hpp"
 #include "solvers/types.hpp"
 
 namespace odelib {
 
-template <OdeSolution Sol>
-bool SuitedForAdaptiveMethod(const Sol& sol, const SizeArgs& args) {
-  if (sol.empty()) {
-    std::cerr << "PlainAdaptiveMethod: you must provide a non-empty solution"
-        << std::endl;
-    return false;
-  }
+inline bool SuitedForAdaptiveMethod(const SizeArgs& args) {
   if (args.tolerance <= 0) {
     std::cerr << "PlainAdaptiveMethod: tolerance must be > 0!" << std::endl;
     return false;
@@ -33,30 +32,170 @@ bool SuitedForAdaptiveMethod(const Sol& sol, const SizeArgs& args) {
   return true;
 }
 
-template <IvpDerivative D, PlainAdaptiveMethod Met, OdeSolution Sol>
+template <OdeSolution Sol>
+bool SuitedForAdaptiveMethod(const Sol& sol, const SizeArgs& args) {
+  if (sol.empty()) {
+    std::cerr << "PlainAdaptiveMethod: you must provide a non-empty solution"
+        << std::endl;
+    return false;
+  }
+  return SuitedForAdaptiveMethod(args);
+}
+
+/**
+ * The Cache of a CachingAdaptiveMethod for problems of dimension N,
+ * and an empty class for the other methods.
+ */
+template <typename Met, int N>
+struct AdaptiveStepCache {
+  struct type {};
+};
+
+template <typename Met, int N>
+requires requires { typename Met::template Cache<N>; }
+struct AdaptiveStepCache<Met, N> {
+  using type = typename Met::template Cache<N>;
+};
+
+/**
+ * AdaptiveStepper
+ *
+ * Takes the steps of an adaptive method from the current point.
+ * If the method is a FsalAdaptiveMethod, the derivative at the current point
+ * is the last evaluation of the step that reached it,
+ * so every accepted step saves one evaluation.
+ * If it is a CachingAdaptiveMethod, the stepper owns its cache,
+ * so what it reuses lives as long as the solve.
+ */
+template <IvpDerivative D, PlainAdaptiveMethod Met>
+class AdaptiveStepper {
+ public:
+  AdaptiveStepper(const Met& met, const D& f, double t,
+      const Vectord<D::kDim>& x)
+    : AdaptiveStepper(met, f, f(t, x)) {}
+
+  /**
+   * The stepper from a point where the derivative dv is already known.
+   */
+  AdaptiveStepper(const Met& met, const D& f, const Vectord<D::kDim>& dv)
+    : met_(met), f_(f), dv_(dv), dv1_(dv) {}
+
+  /**
+   * Steps from (t, x), the point last accepted.
+   */
+  inline std::pair<Vectord<D::kDim>, double> step(double t,
+      const Vectord<D::kDim>& x, double& h, double tol) {
+    if constexpr (kCaching) {
+      return met_.cached_step(f_, t, x, h, tol, cache_);
+    } else if constexpr (kFsal) {
+      return met_.hinted_step(f_, t, x, h, tol, dv_, dv1_);
+    } else {
+      return met_.step(f_, t, x, h, tol);
+    }
+  }
+
+  /**
+   * The size of the first step from (t, x), the point the stepper
+   * started at. See InitialStepSize.
+   * The stepper already has the derivative at the point,
+   * so it costs one evaluation instead of two.
+   */
+  inline double initialStepSize(double t, const Vectord<D::kDim>& x,
+      const SizeArgs& args) const {
+    return InitialStepSize(f_, t, x, dv_, RatioOrder<Met>(), args);
+  }
+
+  /**
+   * The size of the step that follows an accepted one of size step
+   * when h is proposed. If the method declares kHoldStepRatio,
+   * the step is kept while h is larger by at most that factor,
+   * as in RADAU5, so that the work that depends on its size is reused.
+   */
+  inline double nextStepSize(double step, double h) const {
+    if constexpr (requires { Met::kHoldStepRatio; }) {
+      if (step <= h && h <= Met::kHoldStepRatio*step) {
+        return step;
+      }
+    }
+    return h;
+  }
+
+  /**
+   * The continuous extension of the last step accepted,
+   * for the methods whose cache keeps its stages.
+   */
+  inline auto interpolant() requires requires(const Met& met, const D& f,
+      typename AdaptiveStepCache<Met, D::kDim>::type& cache) {
+    met.interpolant(f, cache);
+  } {
+    return met_.interpolant(f_, cache_);
+  }
+
+  /**
+   * Moves to the point reached by the last step.
+   */
+  inline void accept() {
+    if constexpr (kFsal) {
+      std::swap(dv_, dv1_);
+    }
+    if constexpr (kCaching) {
+      cache_.accept();
+    }
+  }
+
+ private:
+  static constexpr bool kFsal = FsalAdaptiveMethod<Met, D>;
+  static constexpr bool kCaching = CachingAdaptiveMethod<Met, D>;
+
+  const Met& met_;
+  const D& f_;
+  Vectord<D::kDim> dv_;
+  Vectord<D::kDim> dv1_;
+  typename AdaptiveStepCache<Met, D::kDim>::type cache_;
+};
+
+/**
+ * Hands the continuous extension of the step just accepted to the sink,
+ * if the sink takes them and the stepper has them.
+ * See SolutionSink.
+ */
+template <typename Stepper, typename Sink>
+inline void HandInterpolant(Stepper& stepper, Sink& sink) {
+  if constexpr (requires { sink.onStepInterpolated(stepper.interpolant()); }) {
+    sink.onStepInterpolated(stepper.interpolant());
+  }
+}
+
+template <IvpDerivative D, PlainAdaptiveMethod Met, OdeSolution Sol,
+    StepSizeController Ctrl = PredictivePIController>
 SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
-    const SizeArgs& args) {
+    const SizeArgs& args, Ctrl ctrl = Ctrl()) {
   if (!SuitedForAdaptiveMethod(sol, args)) {
     return SolverResult::kViolatedPrecondition;
   }
 
-  // Theoritically, we could start with the minimum step possible
-  // because it would automatically increase and we would not fail
-  // a few first steps. But according to the solutions obtained
-  // for arenstorf's problem, it seems best to start with maximum step.
-  // Further investigation is required.
-  double h = args.maxStepAllowed;
   double tol = args.tolerance;
+  constexpr int k = RatioOrder<Met>();
   double t = sol.t.back();
   const auto& x = sol.x;
+  AdaptiveStepper stepper(met, f, t, x.back());
+  double h = stepper.initialStepSize(t, x.back(), args);
   while (t < args.maxTime) {
-    // h is passed by referenced to the method
-    // this is the value used in the current step.
+    // The size proposed by the method through h is replaced
+    // by the one of the controller, unless the stepper holds the step
     double step = h;
-    auto [y, err] = met.step(f, t, x.back(), h, tol);
-    if (err < step*tol) {
+    auto [y, err] = stepper.step(t, x.back(), h, tol);
+    double allowed = AllowedError<Met>(step, tol, x.back(), y);
+    if (err < allowed) {
       t += step;
-      sol.addPoint(t, y);
+      if (!AddSolutionPoint(sol, t, y)) {
+        return SolverResult::kFailedToGrowSolution;
+      }
+      stepper.accept();
+      h = stepper.nextStepSize(step,
+          ctrl.accepted(step, err/allowed, k));
+    } else {
+      h = ctrl.rejected(step, err/allowed, k);
     }
     if (h < args.minStepAllowed) {
       //TODO find if this check is important (and comment here after)
@@ -72,29 +211,39 @@ SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
 }
 
 template <IvpDerivative D, PlainAdaptiveMethod Met, OdeSolution Sol,
-    CrossFunction Cross>
-SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
-    const SizeArgs& args) {
+    CrossFunction StopCond, StepSizeController Ctrl = PredictivePIController>
+SolverResult ExtendPastZero(Sol& sol, const Met& met, const D& f,
+    const SizeArgs& args, const StopCond& cross, Ctrl ctrl = Ctrl()) {
   if (!SuitedForAdaptiveMethod(sol, args)) {
     return SolverResult::kViolatedPrecondition;
   }
 
-  double h = args.minStepAllowed;
   double tol = args.tolerance;
+  constexpr int k = RatioOrder<Met>();
   double t = sol.t.back();
   const auto& x = sol.x;
   double sgn0 = cross(t, sol.x.back());
+  AdaptiveStepper stepper(met, f, t, x.back());
+  double h = stepper.initialStepSize(t, x.back(), args);
   while (t < args.maxTime) {
     double step = h;
-    auto [y, err] = met.step(f, t, x.back(), h, tol);
-    if (err < step*tol) {
+    auto [y, err] = stepper.step(t, x.back(), h, tol);
+    double allowed = AllowedError<Met>(step, tol, x.back(), y);
+    if (err < allowed) {
       t += step;
-      sol.addPoint(t, y);
+      if (!AddSolutionPoint(sol, t, y)) {
+        return SolverResult::kFailedToGrowSolution;
+      }
+      stepper.accept();
+      h = stepper.nextStepSize(step,
+          ctrl.accepted(step, err/allowed, k));
       double sgn1 = cross(t, y);
       if (sgn0*sgn1 < 0) {
         return SolverResult::kOk;
       }
       sgn0 = sgn1;
+    } else {
+      h = ctrl.rejected(step, err/allowed, k);
     }
     if (h < args.minStepAllowed) {
       //TODO find if this check is important (and comment here after)
@@ -109,6 +258,140 @@ SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
   return SolverResult::kExhaustedInterval;
 }
 
+/**
+ * Integrates from (t, x) past the maximum time,
+ * handing every accepted point and every rejected step to the sink
+ * instead of storing them.
+ * Only the current point is kept, so memory use is constant
+ * and no allocation happens during the integration.
+ * Like every adaptive solver, it starts with the step of InitialStepSize
+ * and takes the next sizes from a copy of the controller ctrl.
+ * See StepSizeController.
+ */
+template <IvpDerivative D, PlainAdaptiveMethod Met,
+    SolutionSink<D::kDim> Sink,
+    StepSizeController Ctrl = PredictivePIController>
+SolverResult StreamPastMaxTime(double t, Vectord<D::kDim> x, const Met& met,
+    const D& f, const SizeArgs& args, Sink&& sink, Ctrl ctrl = Ctrl()) {
+  return StreamPastMaxTime(t, x, f(t, x), met, f, args, sink, ctrl);
+}
+
+/**
+ * StreamPastMaxTime from (t, x), given the derivative dv there.
+ */
+template <IvpDerivative D, PlainAdaptiveMethod Met,
+    SolutionSink<D::kDim> Sink,
+    StepSizeController Ctrl = PredictivePIController>
+SolverResult StreamPastMaxTime(double t, Vectord<D::kDim> x,
+    const Vectord<D::kDim>& dv, const Met& met, const D& f,
+    const SizeArgs& args, Sink&& sink, Ctrl ctrl = Ctrl()) {
+  if (!SuitedForAdaptiveMethod(args)) {
+    sink.onFinished(SolverResult::kViolatedPrecondition);
+    return SolverResult::kViolatedPrecondition;
+  }
+  double tol = args.tolerance;
+  constexpr int k = RatioOrder<Met>();
+  AdaptiveStepper stepper(met, f, dv);
+  double h = stepper.initialStepSize(t, x, args);
+  while (t < args.maxTime) {
+    double step = h;
+    auto [y, err] = stepper.step(t, x, h, tol);
+    double allowed = AllowedError<Met>(step, tol, x, y);
+    if (err < allowed) {
+      t += step;
+      x = y;
+      stepper.accept();
+      h = stepper.nextStepSize(step,
+          ctrl.accepted(step, err/allowed, k));
+      sink.onPointAccepted(t, x);
+      HandInterpolant(stepper, sink);
+    } else {
+      h = ctrl.rejected(step, err/allowed, k);
+      sink.onStepRejected(t, step);
+    }
+    if (h < args.minStepAllowed) {
+      if (step > args.minStepAllowed) {
+        h = args.minStepAllowed;
+      } else {
+        sink.onFinished(SolverResult::kStepWentBelowMin);
+        return SolverResult::kStepWentBelowMin;
+      }
+    }
+    h = std::min(h, args.maxStepAllowed);
+  }
+  sink.onFinished(SolverResult::kOk);
+  return SolverResult::kOk;
+}
+
+/**
+ * Integrates from (t, x) until the cross function changes sign,
+ * handing every accepted point and every rejected step to the sink.
+ * The last point handed to the sink is the first one past the zero.
+ */
+template <IvpDerivative D, PlainAdaptiveMethod Met,
+    SolutionSink<D::kDim> Sink, CrossFunction StopCond,
+    StepSizeController Ctrl = PredictivePIController>
+SolverResult StreamPastZero(double t, Vectord<D::kDim> x, const Met& met,
+    const D& f, const SizeArgs& args, const StopCond& cross, Sink&& sink,
+    Ctrl ctrl = Ctrl()) {
+  return StreamPastZero(t, x, f(t, x), met, f, args, cross, sink, ctrl);
+}
+
+/**
+ * StreamPastZero from (t, x), given the derivative dv there.
+ */
+template <IvpDerivative D, PlainAdaptiveMethod Met,
+    SolutionSink<D::kDim> Sink, CrossFunction StopCond,
+    StepSizeController Ctrl = PredictivePIController>
+SolverResult StreamPastZero(double t, Vectord<D::kDim> x,
+    const Vectord<D::kDim>& dv, const Met& met, const D& f,
+    const SizeArgs& args, const StopCond& cross, Sink&& sink,
+    Ctrl ctrl = Ctrl()) {
+  if (!SuitedForAdaptiveMethod(args)) {
+    sink.onFinished(SolverResult::kViolatedPrecondition);
+    return SolverResult::kViolatedPrecondition;
+  }
+  double tol = args.tolerance;
+  constexpr int k = RatioOrder<Met>();
+  double sgn0 = cross(t, x);
+  AdaptiveStepper stepper(met, f, dv);
+  double h = stepper.initialStepSize(t, x, args);
+  while (t < args.maxTime) {
+    double step = h;
+    auto [y, err] = stepper.step(t, x, h, tol);
+    double allowed = AllowedError<Met>(step, tol, x, y);
+    if (err < allowed) {
+      t += step;
+      x = y;
+      stepper.accept();
+      h = stepper.nextStepSize(step,
+          ctrl.accepted(step, err/allowed, k));
+      sink.onPointAccepted(t, x);
+      HandInterpolant(stepper, sink);
+      double sgn1 = cross(t, x);
+      if (sgn0*sgn1 < 0) {
+        sink.onFinished(SolverResult::kOk);
+        return SolverResult::kOk;
+      }
+      sgn0 = sgn1;
+    } else {
+      h = ctrl.rejected(step, err/allowed, k);
+      sink.onStepRejected(t, step);
+    }
+    if (h < args.minStepAllowed) {
+      if (step > args.minStepAllowed) {
+        h = args.minStepAllowed;
+      } else {
+        sink.onFinished(SolverResult::kStepWentBelowMin);
+        return SolverResult::kStepWentBelowMin;
+      }
+    }
+    h = std::min(h, args.maxStepAllowed);
+  }
+  sink.onFinished(SolverResult::kExhaustedInterval);
+  return SolverResult::kExhaustedInterval;
+}
+
 }  // namespace odelib
 
 #endif // INCLUDE_SOLVERS_PLAIN_ADAPTIVE_METHOD_SOLVER_HPP_
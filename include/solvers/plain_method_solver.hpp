@@ -3,13 +3,32 @@
 
 #include <algorithm>
 #include "initial_value_problem.hpp"
+#include "methods/interfaces/plain_adaptive_method.hpp"
 #include "methods/interfaces/plain_method.hpp"
 #include "ode_solution.hpp"
+#include "solution_sink.hpp"
+#include "solutions/history_window.hpp"
 #include "solvers/types.hpp"
 #include "solvers/cross_function.hpp"
 
 namespace odelib {
 
+/**
+ * A PlainMethod that is not a PlainAdaptiveMethod too.
+ * The methods that are both, like the embedded Runge-Kutta methods,
+ * are integrated by the adaptive solvers.
+ */
+template <typename Met>
+concept FixedStepMethod = PlainMethod<Met> && !PlainAdaptiveMethod<Met>;
+
+inline bool SuitedForPlainMethod(const SizeArgs& args) {
+  if (args.fixedStepSize <= 0) {
+    std::cerr << "PlainMethod: fixedStepSize must be > 0!" << std::endl;
+    return false;
+  }
+  return true;
+}
+
 template <OdeSolution Sol>
 bool SuitedForPlainMethod(const Sol& sol, const SizeArgs& args) {
   if (sol.empty()) {
@@ -17,39 +36,90 @@ bool SuitedForPlainMethod(const Sol& sol, const SizeArgs& args) {
         << std::endl;
     return false;
   }
-  if (args.fixedStepSize <= 0) {
-    std::cerr << "PlainMethod: fixedStepSize must be > 0!" << std::endl;
-    return false;
-  }
-  return true;
+  return SuitedForPlainMethod(args);
 }
 
-template <PlainMethod Met, IvpDerivative D, OdeSolution Sol>
-void AppendNSteps(Sol& sol, const Met& met, const D& f, double h, int n) {
-    double t = sol.t.back();
-    int zero = sol.size();
-    n += zero;
-    sol.resize(n);
-    for (int i = zero; i < n; ++i) {
+/**
+ * Appends n steps of size h to the solution.
+ * Returns false, without taking any, if the solution cannot grow.
+ *
+ * When the solution stores derivatives, the derivative at each point
+ * is computed once and passed to the method as a hint for the next step.
+ * Otherwise, no derivative is evaluated apart from those of the method,
+ * and an InPlaceMethod writes each step directly into the solution.
+ */
+template <FixedStepMethod Met, IvpDerivative D, OdeSolution Sol>
+bool AppendNSteps(Sol& sol, const Met& met, const D& f, double h, size_t n) {
+  double t = sol.t.back();
+  size_t zero = sol.size();
+  n += zero;
+  if constexpr (Sol::kStoresDerivatives) {
+    Vectord<Sol::kDim> d = sol.containsDerivatives()?
+        Vectord<Sol::kDim>(sol.dv[zero-1]) : f(t, sol.x[zero-1]);
+    if (!ResizeSolution(sol, n)) {
+      return false;
+    }
+    for (size_t i = zero; i < n; ++i) {
+      sol.x[i] = met.hinted_step(f, t, sol.x[i-1], h, d);
+      sol.t[i] = t += h;
+      d = f(sol.t[i], sol.x[i]);
+      sol.dv[i] = d;
+    }
+  } else if constexpr (InPlaceMethod<Met, D>) {
+    if (!ResizeSolution(sol, n)) {
+      return false;
+    }
+    Vectord<Sol::kDim> work(sol.x[zero-1].size());
+    for (size_t i = zero; i < n; ++i) {
+      sol.x[i] = sol.x[i-1];
+      met.advance(f, t, sol.x[i], h, work);
+      sol.t[i] = t += h;
+    }
+  } else {
+    if (!ResizeSolution(sol, n)) {
+      return false;
+    }
+    for (size_t i = zero; i < n; ++i) {
       sol.x[i] = met.step(f, t, sol.x[i-1], h);
       sol.t[i] = t += h;
-      sol.dv[i] = f(sol.t[i], sol.x[i]);
     }
+  }
+  return true;
 }
 
-template <PlainMethod Met, IvpDerivative D, OdeSolution Sol>
+/**
+ * Appends n steps of size h to a HistoryWindow,
+ * handing the evicted points to the sink.
+ */
+template <FixedStepMethod Met, IvpDerivative D, int N, int Size,
+    SolutionSink<N> Sink = DiscardSink>
+void AppendNSteps(HistoryWindow<N, Size>& window, const Met& met, const D& f,
+    double h, size_t n, Sink&& sink = Sink()) {
+  double t = window.t.back();
+  Vectord<N> d = window.dv.back();
+  for (size_t i = 0; i < n; ++i) {
+    Vectord<N> y = met.hinted_step(f, t, window.x.back(), h, d);
+    t += h;
+    d = f(t, y);
+    window.addPoint(t, y, d, sink);
+  }
+}
+
+template <FixedStepMethod Met, IvpDerivative D, OdeSolution Sol>
 SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
     const SizeArgs& args) {
   if (!SuitedForPlainMethod(sol, args)) {
     return SolverResult::kViolatedPrecondition;
   }
   double h = args.fixedStepSize;
-  int iter = std::max(std::ceil((args.maxTime - sol.t.back())/h), 0.0);
-  AppendNSteps(sol, met, f, h, iter);
+  size_t iter = std::max(std::ceil((args.maxTime - sol.t.back())/h), 0.0);
+  if (!AppendNSteps(sol, met, f, h, iter)) {
+    return SolverResult::kFailedToGrowSolution;
+  }
   return SolverResult::kOk;
 }
 
-template <PlainMethod Met, IvpDerivative D, OdeSolution Sol,
+template <FixedStepMethod Met, IvpDerivative D, OdeSolution Sol,
     CrossFunction StopCond>
 SolverResult ExtendPastZero(Sol& sol, const Met& met, const D& f,
     const SizeArgs& args, const StopCond& cross) {
@@ -59,9 +129,25 @@ SolverResult ExtendPastZero(Sol& sol, const Met& met, const D& f,
   double t = sol.t.back();
   double h = args.fixedStepSize;
   double sgn0 = cross(t, sol.x.back());
+  Vectord<Sol::kDim> d;
+  if constexpr (Sol::kStoresDerivatives) {
+    d = sol.containsDerivatives()? Vectord<Sol::kDim>(sol.dv.back()) :
+        f(t, sol.x.back());
+  }
   while (t < args.maxTime) {
-    sol.addPoint(t + h, met.step(f, t, sol.x.back(), h));
-    t += h;
+    if constexpr (Sol::kStoresDerivatives) {
+      Vectord<Sol::kDim> y = met.hinted_step(f, t, sol.x.back(), h, d);
+      t += h;
+      d = f(t, y);
+      if (!AddSolutionPoint(sol, t, y, d)) {
+        return SolverResult::kFailedToGrowSolution;
+      }
+    } else {
+      if (!AddSolutionPoint(sol, t + h, met.step(f, t, sol.x.back(), h))) {
+        return SolverResult::kFailedToGrowSolution;
+      }
+      t += h;
+    }
     double sgn1 = cross(t, sol.x.back());
     // If different sign -> we have crossed a zero
     // No matter that cross(t0, x0) == 0,
@@ -78,6 +164,84 @@ SolverResult ExtendPastZero(Sol& sol, const Met& met, const D& f,
   return SolverResult::kExhaustedInterval;
 }
 
+/**
+ * Integrates from (t, x) past the maximum time,
+ * handing every new point to the sink instead of storing it.
+ * Only the current point is kept, so memory use is constant
+ * and no allocation happens during the integration.
+ * An InPlaceMethod overwrites it with a single work vector.
+ */
+template <FixedStepMethod Met, IvpDerivative D, SolutionSink<D::kDim> Sink>
+SolverResult StreamPastMaxTime(double t, Vectord<D::kDim> x, const Met& met,
+    const D& f, const SizeArgs& args, Sink&& sink) {
+  if (!SuitedForPlainMethod(args)) {
+    sink.onFinished(SolverResult::kViolatedPrecondition);
+    return SolverResult::kViolatedPrecondition;
+  }
+  double h = args.fixedStepSize;
+  size_t iter = std::max(std::ceil((args.maxTime - t)/h), 0.0);
+  if constexpr (InPlaceMethod<Met, D>) {
+    Vectord<D::kDim> work(x.size());
+    for (size_t i = 0; i < iter; ++i) {
+      met.advance(f, t, x, h, work);
+      t += h;
+      sink.onPointAccepted(t, x);
+    }
+  } else {
+    Vectord<D::kDim> d = f(t, x);
+    for (size_t i = 0; i < iter; ++i) {
+      x = met.hinted_step(f, t, x, h, d);
+      t += h;
+      d = f(t, x);
+      sink.onPointAccepted(t, x);
+    }
+  }
+  sink.onFinished(SolverResult::kOk);
+  return SolverResult::kOk;
+}
+
+/**
+ * Integrates from (t, x) until the cross function changes sign,
+ * handing every new point to the sink instead of storing it.
+ * The last point handed to the sink is the first one past the zero.
+ */
+template <FixedStepMethod Met, IvpDerivative D, SolutionSink<D::kDim> Sink,
+    CrossFunction StopCond>
+SolverResult StreamPastZero(double t, Vectord<D::kDim> x, const Met& met,
+    const D& f, const SizeArgs& args, const StopCond& cross, Sink&& sink) {
+  if (!SuitedForPlainMethod(args)) {
+    sink.onFinished(SolverResult::kViolatedPrecondition);
+    return SolverResult::kViolatedPrecondition;
+  }
+  double h = args.fixedStepSize;
+  double sgn0 = cross(t, x);
+  Vectord<D::kDim> d(x.size());
+  if constexpr (!InPlaceMethod<Met, D>) {
+    d = f(t, x);
+  }
+  while (t < args.maxTime) {
+    if constexpr (InPlaceMethod<Met, D>) {
+      // d is only work space
+      met.advance(f, t, x, h, d);
+      t += h;
+    } else {
+      x = met.hinted_step(f, t, x, h, d);
+      t += h;
+      d = f(t, x);
+    }
+    sink.onPointAccepted(t, x);
+    double sgn1 = cross(t, x);
+    // See ExtendPastZero for the case sgn0 == 0
+    if (sgn0*sgn1 < 0 || sgn1 == 0) {
+      sink.onFinished(SolverResult::kOk);
+      return SolverResult::kOk;
+    }
+    sgn0 = sgn1;
+  }
+  sink.onFinished(SolverResult::kExhaustedInterval);
+  return SolverResult::kExhaustedInterval;
+}
+
 }  // namespace odelib
 
 #endif  // INCLUDE_SOLVERS_PLAIN_METHOD_SOLVER_HPP_
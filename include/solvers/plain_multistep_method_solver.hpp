@@ -5,6 +5,8 @@
 #include "initial_value_problem.hpp"
 #include "methods/interfaces/plain_multistep_method.hpp"
 #include "ode_solution.hpp"
+#include "solution_sink.hpp"
+#include "solutions/history_window.hpp"
 #include "solvers/plain_method_solver.hpp"
 #include "solvers/types.hpp"
 
@@ -12,7 +14,7 @@ namespace odelib {
 
 template <OdeSolution Sol>
 bool SuitedForMultistepMethod(const Sol& sol, const SizeArgs& args, int steps) {
-  if ((int) sol.size() < steps + 1) {
+  if (sol.size() < static_cast<size_t>(steps) + 1) {
     std::cerr << "PlainMultistepMethod: you must provide a solution with "
         << steps << " steps!" << std::endl;
     return false;
@@ -25,7 +27,8 @@ bool SuitedForMultistepMethod(const Sol& sol, const SizeArgs& args, int steps) {
   return true;
 }
 
-template <PlainMultistepMethod Met, IvpDerivative D, OdeSolution Sol>
+template <PlainMultistepMethod Met, IvpDerivative D,
+    OdeSolutionWithDerivatives Sol>
 SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
     const SizeArgs& args) {
   constexpr int nsteps = met.kNeededSteps;
@@ -36,10 +39,12 @@ SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
   auto& t = sol.t;
   auto& x = sol.x;
   auto& dv = sol.dv;
-  int zero = sol.size();
-  int iter = zero + std::max(std::ceil((args.maxTime - t.back())/h), 0.0);
-  sol.resize(iter);
-  for (int i = zero; i < iter; ++i) {
+  size_t zero = sol.size();
+  size_t iter = zero + std::max(std::ceil((args.maxTime - t.back())/h), 0.0);
+  if (!ResizeSolution(sol, iter)) {
+    return SolverResult::kFailedToGrowSolution;
+  }
+  for (size_t i = zero; i < iter; ++i) {
     x[i] = met.step(f, t[i-1], &x[i-1]-nsteps, h, &dv[i-1]-nsteps);
     t[i] = t[i-1] + h;
     dv[i] = f(t[i], x[i]);
@@ -47,8 +52,37 @@ SolverResult ExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
   return SolverResult::kOk;
 }
 
-template <IvpDerivative D, PlainMultistepMethod Met, OdeSolution Sol,
-    CrossFunction StopCond>
+/**
+ * Extends a HistoryWindow past the maximum time.
+ * Only the points the method needs are kept,
+ * and the older ones are handed to the sink as accepted points,
+ * so memory use does not depend on the length of the integration.
+ * The sink is not finished, since the window still holds the last points:
+ * drain the window into it before calling its onFinished.
+ */
+template <PlainMultistepMethod Met, IvpDerivative D, int N, int Size,
+    SolutionSink<N> Sink = DiscardSink>
+SolverResult ExtendPastMaxTime(HistoryWindow<N, Size>& window, const Met& met,
+    const D& f, const SizeArgs& args, Sink&& sink = Sink()) {
+  constexpr int nsteps = met.kNeededSteps;
+  static_assert(Size >= nsteps + 1, "The window cannot hold the history");
+  if (!SuitedForMultistepMethod(window, args, nsteps)) {
+    return SolverResult::kViolatedPrecondition;
+  }
+  double h = args.fixedStepSize;
+  size_t iter = std::max(std::ceil((args.maxTime - window.t.back())/h), 0.0);
+  for (size_t i = 0; i < iter; ++i) {
+    double t = window.t.back();
+    size_t first = window.size() - (nsteps+1);
+    Vectord<N> y = met.step(f, t, window.x.data() + first, h,
+        window.dv.data() + first);
+    window.addPoint(t + h, y, f(t + h, y), sink);
+  }
+  return SolverResult::kOk;
+}
+
+template <IvpDerivative D, PlainMultistepMethod Met,
+    OdeSolutionWithDerivatives Sol, CrossFunction StopCond>
 SolverResult ExtendPastZero(const Met& met, Sol& sol, const D& f,
     const SizeArgs& args, const StopCond& cross) {
   constexpr int nsteps = met.kNeededSteps();
@@ -6,6 +6,8 @@
 #include "initial_value_problem.hpp"
 #include "methods/interfaces/plain_implicit_method.hpp"
 #include "ode_solution.hpp"
+#include "solution_sink.hpp"
+#include "solutions/history_window.hpp"
 #include "solvers/types.hpp"
 
 namespace odelib {
@@ -35,7 +37,7 @@ struct Secant1d {
 // We need two points to use the secant solver
 template <OdeSolution Sol>
 bool SuitedForSecantPlainImplicitMethod(const Sol& sol, const SizeArgs& args) {
-  if ((int) sol.size() < 2) {
+  if (sol.size() < 2) {
     std::cerr << "Secant: you must provide a solution with at least 2 points"
         << std::endl;
     return false;
@@ -53,14 +55,16 @@ bool SuitedForSecantPlainImplicitMethod(const Sol& sol, const SizeArgs& args) {
 
 template <PlainImplicitMethod Met, IvpDerivative D, OdeSolution Sol>
 SolverResult SecantAppendNSteps(Sol& sol, const Met& met, const D& f, double h,
-    double tol, int n) {
+    double tol, size_t n) {
   Secant1d solver;
   double t = sol.t.back();
   auto& x = sol.x;
-  int zero = sol.size();
+  size_t zero = sol.size();
   n += zero;
-  sol.resize(n);
-  for (int i = zero; i < n; ++i) {
+  if (!ResizeSolution(sol, n)) {
+    return SolverResult::kFailedToGrowSolution;
+  }
+  for (size_t i = zero; i < n; ++i) {
     auto [y, converged] =
         solver.solve(met.equation(f, t, x[i-1], h), x[i-2], x[i-1], tol);
     if (!converged) {
@@ -68,7 +72,9 @@ SolverResult SecantAppendNSteps(Sol& sol, const Met& met, const D& f, double h,
     }
     x[i] = y;
     sol.t[i] = t += h;
-    sol.dv[i] = f(sol.t[i], sol.x[i]);
+    if constexpr (Sol::kStoresDerivatives) {
+      sol.dv[i] = f(sol.t[i], sol.x[i]);
+    }
   }
   return SolverResult::kOk;
 }
@@ -80,7 +86,7 @@ SolverResult SecantExtendPastMaxTime(Sol& sol, const Met& met, const D& f,
     return SolverResult::kViolatedPrecondition;
   }
   double h = args.fixedStepSize;
-  int iter = std::max(std::ceil((args.maxTime - sol.t.back())/h), 0.0);
+  size_t iter = std::max(std::ceil((args.maxTime - sol.t.back())/h), 0.0);
   return SecantAppendNSteps(sol, met, f, h, args.tolerance, iter);
 }
 
@@ -106,7 +112,9 @@ SolverResult SecantExtendPastZero(Sol& sol, const Met& met, const D& f,
       return SolverResult::kFailedToSolveImplicitEq;
     }
     t += h;
-    sol.addPoint(t, y);
+    if (!AddSolutionPoint(sol, t, y)) {
+      return SolverResult::kFailedToGrowSolution;
+    }
     double sgn1 = cross(t, x.back());
     if (sgn0*sgn1 < 0) {
       return SolverResult::kOk;
@@ -116,6 +124,38 @@ SolverResult SecantExtendPastZero(Sol& sol, const Met& met, const D& f,
   return SolverResult::kExhaustedInterval;
 }
 
+/**
+ * Extends a HistoryWindow past the maximum time.
+ * The secant iteration starts from the last two points,
+ * so the window keeps at least two, and the older ones are handed
+ * to the sink as accepted points.
+ * The sink is not finished, since the window still holds the last points:
+ * drain the window into it before calling its onFinished.
+ */
+template <IvpDerivative D, PlainImplicitMethod Met, int N, int Size,
+    SolutionSink<N> Sink = DiscardSink>
+SolverResult SecantExtendPastMaxTime(HistoryWindow<N, Size>& window,
+    const Met& met, const D& f, const SizeArgs& args, Sink&& sink = Sink()) {
+  static_assert(Size >= 2, "The window cannot hold two points");
+  if (!SuitedForSecantPlainImplicitMethod(window, args)) {
+    return SolverResult::kViolatedPrecondition;
+  }
+  Secant1d solver;
+  double h = args.fixedStepSize;
+  const auto& x = window.x;
+  size_t iter = std::max(std::ceil((args.maxTime - window.t.back())/h), 0.0);
+  for (size_t i = 0; i < iter; ++i) {
+    double t = window.t.back();
+    auto [y, converged] = solver.solve(met.equation(f, t, x.back(), h),
+        x[x.size()-2], x.back(), args.tolerance);
+    if (!converged) {
+      return SolverResult::kFailedToSolveImplicitEq;
+    }
+    window.addPoint(t + h, y, f(t + h, y), sink);
+  }
+  return SolverResult::kOk;
+}
+
 }  // namespace odelib
 
 #endif  // INCLUDE_SOLVERS_SECANT_IMPLICIT_SOLVER_HPP_
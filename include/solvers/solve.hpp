@@ -11,6 +11,7 @@
 #include "solvers/plain_multistep_method_solver.hpp"
 #include "solvers/adaptive_multistep_method_solver.hpp"
 #include "solvers/newton_implicit_solver.hpp"
+#include "solvers/nordsieck_method_solver.hpp"
 #include "solvers/secant_implicit_solver.hpp"
 
 namespace odelib {
@@ -0,0 +1,228 @@
+#ifndef INCLUDE_SOLVERS_STEP_SIZE_CONTROLLERS_HPP_
+#define INCLUDE_SOLVERS_STEP_SIZE_CONTROLLERS_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include "tools/unroll.hpp"
+
+namespace odelib {
+
+/**
+ * StepSizeController
+ * Chooses the size of the next step of an adaptive solver
+ * from the error of the last one.
+ *
+ * r is the error of the step of size h relative to the error allowed,
+ * err/AllowedError<Met>(h, tol, x, y), so the step is accepted when r < 1,
+ * and k is its order in h, RatioOrder<Met>.
+ * Controllers may keep the errors of the previous steps,
+ * so the solvers copy them at the start of each solve.
+ */
+template <typename C>
+concept StepSizeController = std::copyable<C> && requires(C c, double h,
+    double r, int k) {
+  { c.accepted(h, r, k) } -> std::same_as<double>;
+  { c.rejected(h, r, k) } -> std::same_as<double>;
+};
+
+/**
+ * The order of the error estimate of an adaptive method,
+ * its kErrorOrder if it declares one and its kOrder otherwise.
+ */
+template <typename Met>
+constexpr int ErrorOrder() {
+  if constexpr (requires { Met::kErrorOrder; }) {
+    return Met::kErrorOrder;
+  } else {
+    return Met::kOrder;
+  }
+}
+
+/**
+ * Whether an adaptive method bounds its error per step,
+ * by tol*(1 + |x|), instead of per unit step, by h*tol.
+ * It does if it declares kErrorPerStep true.
+ */
+template <typename Met>
+constexpr bool ErrorPerStep() {
+  if constexpr (requires { Met::kErrorPerStep; }) {
+    return Met::kErrorPerStep;
+  } else {
+    return false;
+  }
+}
+
+/**
+ * The order in h of the ratio of the error of a step to the error
+ * allowed: ErrorOrder<Met>, plus one if the error is bounded per step,
+ * since the allowed error does not shrink with h then.
+ */
+template <typename Met>
+constexpr int RatioOrder() {
+  return ErrorOrder<Met>() + (ErrorPerStep<Met>()? 1 : 0);
+}
+
+/**
+ * The error allowed to a method in a step of size h from x to y,
+ * h*tol, or tol*(1 + |x|) if it bounds the error per step,
+ * but never less than kRoundingErrors roundings of x and y - x.
+ * Estimates that small are mostly the rounding of the stages,
+ * which smaller steps do not lower, so with tolerances near the
+ * machine precision the steps would shrink until they went below
+ * the minimum allowed.
+ */
+template <typename Met, typename X, typename Y>
+inline double AllowedError(double h, double tol, const X& x, const Y& y) {
+  constexpr double kRoundingErrors = 64;
+  double rounding = kRoundingErrors*std::numeric_limits<double>::epsilon()*
+      (x.norm() + (y - x).norm());
+  double allowed = ErrorPerStep<Met>()? tol*(1 + x.norm()) : h*tol;
+  return std::max(allowed, rounding);
+}
+
+/**
+ * StepSizeFilter
+ * The coefficients of a digital filter in Söderlind's form,
+ *
+ *   h_{n+1}/h_n = (1/r_n)^(b[0]/k) (1/r_{n-1})^(b[1]/k) (1/r_{n-2})^(b[2]/k)
+ *                 (h_n/h_{n-1})^(-a[0]) (h_{n-1}/h_{n-2})^(-a[1]),
+ *
+ * given as constexpr class variables.
+ */
+template <typename F>
+concept StepSizeFilter = requires {
+  { F::b[2] } -> std::convertible_to<double>;
+  { F::a[1] } -> std::convertible_to<double>;
+};
+
+/**
+ * Step Size Controller of a StepSizeFilter
+ *
+ * For safety, the filter aims at relative errors of 0.7 instead of 1,
+ * using 0.7/r for 1/r, so that every filter settles at the same error
+ * whatever the sum of its coefficients.
+ * The new step is limited to [0.1, 4] times the last one.
+ * Only the accepted steps enter the filter. A rejected step is retried
+ * with the elementary controller, and the step after a rejection
+ * cannot grow, so that the controller does not cycle around the
+ * tolerance rejecting every other step.
+ */
+template <StepSizeFilter F>
+class FilterController {
+ public:
+  inline double accepted(double h, double r, int k) {
+    r = std::max(r, kMinRatio);
+    double ratios[3] = {r, r_[0], r_[1]};
+    double rho[2] = {h1_ > 0? h/h1_ : 1, rho_};
+    double factor = 1;
+    Unroll<3>([&](auto i) {
+      if constexpr (F::b[i] != 0) {
+        factor *= std::pow(kTarget/ratios[i], F::b[i]/k);
+      }
+    });
+    Unroll<2>([&](auto i) {
+      if constexpr (F::a[i] != 0) {
+        factor *= std::pow(rho[i], -F::a[i]);
+      }
+    });
+    factor = std::max(kMinFactor, std::min(factor, kMaxFactor));
+    if (rejected_) {
+      factor = std::min(factor, 1.0);
+      rejected_ = false;
+    }
+    r_[1] = r_[0];
+    r_[0] = r;
+    rho_ = rho[0];
+    h1_ = h;
+    return h*factor;
+  }
+
+  inline double rejected(double h, double r, int k) {
+    rejected_ = true;
+    double factor = std::pow(kTarget/r, 1.0/k);
+    return h*std::max(kMinFactor, factor);
+  }
+
+ private:
+  static constexpr double kTarget = 0.7;
+  static constexpr double kMinFactor = 0.1;
+  static constexpr double kMaxFactor = 4;
+  // Smaller ratios are taken as this one, since a null error
+  // would make the filter undefined
+  static constexpr double kMinRatio = 1e-10;
+
+  // Relative errors of the last two accepted steps,
+  // taken at the target before there are any
+  double r_[2] = {kTarget, kTarget};
+  // Size of the last accepted step, 0 before there is any,
+  // and its ratio to the one before
+  double h1_ = 0;
+  double rho_ = 1;
+  bool rejected_ = false;
+};
+
+/**
+ * Elementary controller, h_{n+1} = h_n (0.7/r_n)^(1/k).
+ */
+struct ElementaryFilter {
+  static constexpr double b[] = {1, 0, 0};
+  static constexpr double a[] = {0, 0};
+};
+
+/**
+ * Gustafsson's PI controller, with his coefficients 0.7 and -0.4.
+ * Remembering the last error damps the oscillations of the step size
+ * of the elementary controller.
+ */
+struct GustafssonPIFilter {
+  static constexpr double b[] = {0.7, -0.4, 0};
+  static constexpr double a[] = {0, 0};
+};
+
+/**
+ * Gustafsson's predictive PI controller, which also follows the trend
+ * of the last step size ratio. It does not lag behind the step sizes
+ * that shrink or grow steadily, like those of an orbit that approaches
+ * a body, where the plain PI controller is rejected once and again.
+ */
+struct PredictivePIFilter {
+  static constexpr double b[] = {0.7, -0.4, 0};
+  static constexpr double a[] = {-1, 0};
+};
+
+/**
+ * Söderlind's H211PI digital filter, b = (1/6, 1/6).
+ */
+struct H211PIFilter {
+  static constexpr double b[] = {1/6.0, 1/6.0, 0};
+  static constexpr double a[] = {0, 0};
+};
+
+/**
+ * Söderlind's H211b digital filter, b = (1/4, 1/4), a = (1/4, 0).
+ */
+struct H211bFilter {
+  static constexpr double b[] = {1/4.0, 1/4.0, 0};
+  static constexpr double a[] = {1/4.0, 0};
+};
+
+/**
+ * Söderlind's H312PID digital filter, b = (1/18, 1/9, 1/18).
+ */
+struct H312PIDFilter {
+  static constexpr double b[] = {1/18.0, 1/9.0, 1/18.0};
+  static constexpr double a[] = {0, 0};
+};
+
+using ElementaryController = FilterController<ElementaryFilter>;
+using GustafssonPIController = FilterController<GustafssonPIFilter>;
+using PredictivePIController = FilterController<PredictivePIFilter>;
+using H211PIController = FilterController<H211PIFilter>;
+using H211bController = FilterController<H211bFilter>;
+using H312PIDController = FilterController<H312PIDFilter>;
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SOLVERS_STEP_SIZE_CONTROLLERS_HPP_
@@ -0,0 +1,80 @@
+#ifndef INCLUDE_SOLVERS_THINNING_SOLVER_HPP_
+#define INCLUDE_SOLVERS_THINNING_SOLVER_HPP_
+
+#include <utility>
+#include "initial_value_problem.hpp"
+#include "methods/interfaces/plain_adaptive_method.hpp"
+#include "ode_solution.hpp"
+#include "sinks/thinning_sink.hpp"
+#include "solvers/cross_function.hpp"
+#include "solvers/plain_adaptive_method_solver.hpp"
+#include "solvers/step_size_controllers.hpp"
+#include "solvers/types.hpp"
+
+namespace odelib {
+
+/**
+ * The derivative at the last point of the solution,
+ * evaluated only if the solution does not store it.
+ */
+template <OdeSolution Sol, IvpDerivative D>
+Vectord<Sol::kDim> LastDerivative(const Sol& sol, const D& f) {
+  if constexpr (Sol::kStoresDerivatives) {
+    if (sol.containsDerivatives()) {
+      return sol.dv.back();
+    }
+  }
+  return f(sol.t.back(), sol.x.back());
+}
+
+/**
+ * Extends the solution past the maximum time,
+ * storing only the points that cannot be rebuilt within maxError
+ * by cubic Hermite interpolation of the stored ones (see ThinningSink).
+ * Returns the result and the maximum reconstruction error.
+ */
+template <IvpDerivative D, PlainAdaptiveMethod Met, OdeSolution Sol,
+    StepSizeController Ctrl = PredictivePIController>
+std::pair<SolverResult, double> ThinningExtendPastMaxTime(Sol& sol,
+    const Met& met, const D& f, const SizeArgs& args, double maxError,
+    Ctrl ctrl = Ctrl()) {
+  if (!SuitedForAdaptiveMethod(sol, args)) {
+    return {SolverResult::kViolatedPrecondition, 0};
+  }
+  Vectord<Sol::kDim> dv = LastDerivative(sol, f);
+  ThinningSink thinning(sol, f, dv, maxError);
+  SolverResult result = StreamPastMaxTime(sol.t.back(), sol.x.back(), dv,
+      met, f, args, thinning, ctrl);
+  if (thinning.failed()) {
+    result = SolverResult::kFailedToGrowSolution;
+  }
+  return {result, thinning.maxReconstructionError()};
+}
+
+/**
+ * Extends the solution until the cross function changes sign,
+ * storing only the points that cannot be rebuilt within maxError.
+ * The last stored point is the first one past the zero.
+ * Returns the result and the maximum reconstruction error.
+ */
+template <IvpDerivative D, PlainAdaptiveMethod Met, OdeSolution Sol,
+    CrossFunction StopCond, StepSizeController Ctrl = PredictivePIController>
+std::pair<SolverResult, double> ThinningExtendPastZero(Sol& sol,
+    const Met& met, const D& f, const SizeArgs& args, const StopCond& cross,
+    double maxError, Ctrl ctrl = Ctrl()) {
+  if (!SuitedForAdaptiveMethod(sol, args)) {
+    return {SolverResult::kViolatedPrecondition, 0};
+  }
+  Vectord<Sol::kDim> dv = LastDerivative(sol, f);
+  ThinningSink thinning(sol, f, dv, maxError);
+  SolverResult result = StreamPastZero(sol.t.back(), sol.x.back(), dv, met,
+      f, args, cross, thinning, ctrl);
+  if (thinning.failed()) {
+    result = SolverResult::kFailedToGrowSolution;
+  }
+  return {result, thinning.maxReconstructionError()};
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_SOLVERS_THINNING_SOLVER_HPP_
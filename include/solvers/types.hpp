@@ -25,7 +25,8 @@ enum class SolverResult {
   kOk,
   kExhaustedInterval,
   kStepWentBelowMin,
-  kFailedToSolveImplicitEq
+  kFailedToSolveImplicitEq,
+  kFailedToGrowSolution
 };
 
 /**
@@ -49,6 +50,10 @@ bool LogResult(SolverResult result) {
     std::cerr << "Method found it impossible to solve an implicit equation"
         << std::endl;
     break;
+  case SolverResult::kFailedToGrowSolution:
+    std::cerr << "Method could not add more points to the solution"
+        << std::endl;
+    break;
   case SolverResult::kOk:
     std::cerr << "Method finished succesfully" << std::endl;
     return false;
@@ -0,0 +1,167 @@
+#ifndef INCLUDE_TOOLS_BATCH_INTERPOLATION_HPP_
+#define INCLUDE_TOOLS_BATCH_INTERPOLATION_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ode_solution.hpp"
+#include "tools/interpolation.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * SweepInterpolator
+ *
+ * Interpolates a solution at non-decreasing times, giving the same values
+ * as Interpolate with the same useDerivatives, by advancing a cursor
+ * through it.
+ * The interpolant of the current step is kept on the stack
+ * and only rebuilt when the cursor moves to another step.
+ * The solution must outlive the SweepInterpolator and not change meanwhile.
+ */
+template <OdeSolution Os>
+class SweepInterpolator {
+ public:
+  static constexpr int kDim = Os::kDim;
+
+  /**
+   * Places the cursor at the step of the first time to interpolate.
+   */
+  SweepInterpolator(const Os& os, double firstTime,
+      bool useDerivatives = false)
+    : os_(os), n_(os.size()), pos_(LowerBoundTime(os, firstTime)) {
+    if constexpr (Os::kStoresDerivatives) {
+      derivatives_ = useDerivatives && os.containsDerivatives();
+    }
+  }
+
+  /**
+   * Interpolates at time, which must lie after the first point,
+   * not after the last one, and not before the previous time.
+   */
+  Vectord<kDim> operator()(double time) {
+    while (os_.t[pos_] < time) {
+      ++pos_;
+    }
+    if constexpr (Os::kStoresDerivatives) {
+      if (derivatives_) {
+        if (pos_ != built_) {
+          t_[0] = os_.t[pos_-1];
+          t_[1] = os_.t[pos_];
+          x_[0] = os_.x[pos_-1];
+          x_[1] = os_.x[pos_];
+          c_[0] = os_.dv[pos_-1];
+          c_[1] = os_.dv[pos_];
+          built_ = pos_;
+        }
+        return interpolation::CubicHermite(t_[0], x_[0], c_[0], t_[1], x_[1],
+            c_[1], time);
+      }
+    }
+    if (n_ < kInterpolationPoints) {
+      return *Interpolate(os_, time, K-1);
+    }
+    size_t first = InterpolationWindow(pos_, n_);
+    if (first != built_) {
+      for (int i = 0; i < K; ++i) {
+        t_[i] = os_.t[first+i];
+        x_[i] = os_.x[first+i];
+      }
+      c_ = interpolation::NewtonCoefficients<K, kDim>(t_, x_);
+      built_ = first;
+    }
+    return interpolation::EvaluateNewton<K, kDim>(t_, c_, time);
+  }
+
+ private:
+  static constexpr int K = kInterpolationPoints;
+
+  const Os& os_;
+  size_t n_;
+  size_t pos_;
+  bool derivatives_ = false;
+  // Start of the step or window whose interpolant is built
+  size_t built_ = -1;
+  std::array<double, K> t_;
+  std::array<Vectord<kDim>, K> x_;
+  // Newton coefficients, or derivatives at both ends of the step
+  std::array<Vectord<kDim>, K> c_;
+};
+
+namespace batch {
+
+/**
+ * Interpolates the times [k0, k1), which must lie inside the solution.
+ */
+template <OdeSolution Os>
+void Sweep(const Os& os, std::span<const double> times,
+    std::span<Vectord<Os::kDim>> out, size_t k0, size_t k1,
+    bool useDerivatives) {
+  SweepInterpolator<Os> interpolator(os, times[k0], useDerivatives);
+  for (size_t k = k0; k < k1; ++k) {
+    out[k] = interpolator(times[k]);
+  }
+}
+
+}  // namespace batch
+
+/**
+ * Interpolates the solution at many times sorted in increasing order,
+ * writing into out the same values as Interpolate
+ * with the same useDerivatives.
+ *
+ * A SweepInterpolator replaces the binary search of every time,
+ * and builds the interpolant of each step once
+ * for all the times inside it, so the cost is linear
+ * in the number of points and times. Nothing is allocated.
+ * The times can be split into equal ranges swept by up to threads threads.
+ *
+ * Only the times after the first point and not after the last one
+ * can be interpolated. Returns the range [first, last) of their indices;
+ * the values of out outside it are not modified.
+ */
+template <OdeSolution Os>
+std::pair<size_t, size_t> InterpolateMany(const Os& os,
+    std::span<const double> times, std::span<Vectord<Os::kDim>> out,
+    unsigned threads = 1, bool useDerivatives = false) {
+  assert(out.size() >= times.size());
+  assert(std::is_sorted(times.begin(), times.end()));
+  size_t n = os.size();
+  if (n < 2) {
+    return {0, 0};
+  }
+  double tBegin = os.t[0];
+  double tEnd = os.t[n-1];
+  size_t first = std::upper_bound(times.begin(), times.end(), tBegin)
+      - times.begin();
+  size_t last = std::upper_bound(times.begin() + first, times.end(), tEnd)
+      - times.begin();
+  if (first == last) {
+    return {first, last};
+  }
+  size_t count = last - first;
+  // Small ranges are not worth a thread
+  constexpr size_t kMinPerThread = 1 << 14;
+  threads = std::clamp<size_t>(count/kMinPerThread, 1, std::max(threads, 1u));
+  std::vector<std::thread> workers;
+  for (unsigned i = 1; i < threads; ++i) {
+    workers.emplace_back(batch::Sweep<Os>, std::cref(os), times, out,
+        first + count*i/threads, first + count*(i+1)/threads,
+        useDerivatives);
+  }
+  batch::Sweep(os, times, out, first, first + count/threads,
+      useDerivatives);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return {first, last};
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_TOOLS_BATCH_INTERPOLATION_HPP_
@@ -0,0 +1,470 @@
+#ifndef INCLUDE_TOOLS_COMPRESSED_TRAJECTORY_HPP_
+#define INCLUDE_TOOLS_COMPRESSED_TRAJECTORY_HPP_
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "ode_solution.hpp"
+#include "solvers/types.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * How each value of a compressed trajectory is predicted
+ * from the values already stored.
+ * Only the difference between the value and its prediction is stored,
+ * which is small because consecutive states are close.
+ */
+enum class TrajectoryPredictor : uint32_t {
+  // The previous value
+  kPrevious,
+  // Linear extrapolation of the two previous values
+  kLinear,
+  // x[i-1] + (t[i] - t[i-1])*dv[i-1]; the stream also stores dv
+  kDerivative
+};
+
+/**
+ * Header of the compressed trajectory streams.
+ *
+ * The header is followed by one record per point: t, x and,
+ * with the kDerivative predictor, dv. Times are always stored losslessly.
+ * A lossless value is stored as the XOR of its bits and those of its
+ * prediction: one byte with the number of leading (high nibble)
+ * and trailing (low nibble) zero bytes of the XOR, then its other bytes.
+ * With tolerance > 0, x and dv are stored lossily as the varint
+ * 1 + zigzag(q), where value = prediction + q*2*tolerance,
+ * or as a 0 followed by the 8 bytes of the value when q does not fit.
+ * Predictions use the decoded values, so errors do not accumulate.
+ */
+struct CompressedTrajectoryHeader {
+  static constexpr char kMagic[8] = {'O', 'D', 'E', 'L', 'I', 'B', 'X', 'Z'};
+  static constexpr uint32_t kVersion = 1;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t dim;
+  uint32_t predictor;  // a TrajectoryPredictor
+  uint32_t reserved;
+  double tolerance;    // 0 for lossless streams
+};
+
+static_assert(sizeof(CompressedTrajectoryHeader) == 32);
+
+namespace compression {
+
+/**
+ * The predictions of the next point of a trajectory,
+ * shared by the writer and the reader.
+ *
+ * The arithmetic lives in functions that are never inlined,
+ * so that the writer and the reader round identically
+ * even when compiled with --fast-math.
+ */
+template <int N>
+class PointPredictor {
+ public:
+  explicit PointPredictor(TrajectoryPredictor predictor)
+    : predictor_(predictor) {}
+
+  [[gnu::noinline]] double time() const {
+    if (count_ < 2) {
+      return count_ == 0? 0 : t1_;
+    }
+    return t1_ + (t1_ - t0_);
+  }
+
+  // Requires the time of the point being predicted
+  [[gnu::noinline]] Vectord<N> point(double t) const {
+    if (count_ == 0) {
+      return Vectord<N>::Zero();
+    }
+    switch (predictor_) {
+    case TrajectoryPredictor::kLinear:
+      if (count_ >= 2) {
+        return x1_ + (x1_ - x0_);
+      }
+      return x1_;
+    case TrajectoryPredictor::kDerivative: {
+      Vectord<N> p;
+      for (int i = 0; i < N; ++i) {
+        p[i] = std::fma(t - t1_, dv1_[i], x1_[i]);
+      }
+      return p;
+    }
+    default:
+      return x1_;
+    }
+  }
+
+  inline Vectord<N> derivative() const {
+    return count_ == 0? Vectord<N>::Zero() : dv1_;
+  }
+
+  inline void push(double t, const Vectord<N>& x, const Vectord<N>& dv) {
+    t0_ = t1_;
+    x0_ = x1_;
+    t1_ = t;
+    x1_ = x;
+    dv1_ = dv;
+    count_ += count_ < 2;
+  }
+
+ private:
+  TrajectoryPredictor predictor_;
+  int count_ = 0;
+  double t0_ = 0, t1_ = 0;
+  Vectord<N> x0_ = Vectord<N>::Zero();
+  Vectord<N> x1_ = Vectord<N>::Zero();
+  Vectord<N> dv1_ = Vectord<N>::Zero();
+};
+
+// Maximum bytes of a stored value
+constexpr size_t kMaxValueBytes = 10;
+
+inline uint64_t Bits(double v) { return std::bit_cast<uint64_t>(v); }
+inline double FromBits(uint64_t b) { return std::bit_cast<double>(b); }
+
+inline uint8_t* PutXor(uint8_t* out, double v, double p) {
+  uint64_t r = Bits(v) ^ Bits(p);
+  if (r == 0) {
+    *out++ = 0x80;
+    return out;
+  }
+  int lead = std::countl_zero(r)/8;
+  int trail = std::countr_zero(r)/8;
+  *out++ = lead << 4 | trail;
+  r >>= 8*trail;
+  for (int i = trail; i < 8 - lead; ++i, r >>= 8) {
+    *out++ = r;
+  }
+  return out;
+}
+
+inline const uint8_t* GetXor(const uint8_t* in, double p, double& v) {
+  int lead = *in >> 4;
+  int trail = *in++ & 0xf;
+  uint64_t r = 0;
+  for (int i = trail; i < 8 - lead; ++i) {
+    r |= static_cast<uint64_t>(*in++) << 8*i;
+  }
+  v = FromBits(Bits(p) ^ r);
+  return in;
+}
+
+inline uint8_t* PutVarint(uint8_t* out, uint64_t u) {
+  while (u >= 0x80) {
+    *out++ = u | 0x80;
+    u >>= 7;
+  }
+  *out++ = u;
+  return out;
+}
+
+inline const uint8_t* GetVarint(const uint8_t* in, uint64_t& u) {
+  u = 0;
+  for (int shift = 0; ; shift += 7) {
+    uint8_t byte = *in++;
+    u |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return in;
+    }
+  }
+}
+
+[[gnu::noinline]] inline double Dequantize(int64_t q, double step, double p) {
+  return std::fma(static_cast<double>(q), step, p);
+}
+
+/**
+ * Stores v lossily and returns the value the reader will decode.
+ */
+inline uint8_t* PutQuantized(uint8_t* out, double v, double p, double tol,
+    double& decoded) {
+  double step = 2*tol;
+  double q = std::nearbyint((v - p)/step);
+  if (std::abs(q) < 0x1p61) {
+    int64_t iq = static_cast<int64_t>(q);
+    decoded = Dequantize(iq, step, p);
+    if (std::abs(decoded - v) <= tol) {
+      uint64_t zigzag = (static_cast<uint64_t>(iq) << 1) ^ (iq >> 63);
+      return PutVarint(out, zigzag + 1);
+    }
+  }
+  // Not representable: infinite, NaN or too far from the prediction
+  *out++ = 0;
+  std::memcpy(out, &v, 8);
+  decoded = v;
+  return out + 8;
+}
+
+inline const uint8_t* GetQuantized(const uint8_t* in, double p, double tol,
+    double& v) {
+  uint64_t u;
+  in = GetVarint(in, u);
+  if (u == 0) {
+    std::memcpy(&v, in, 8);
+    return in + 8;
+  }
+  --u;
+  int64_t q = static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
+  v = Dequantize(q, 2*tol, p);
+  return in;
+}
+
+}  // namespace compression
+
+/**
+ * CompressedTrajectoryWriter
+ *
+ * Writes a trajectory to an output stream as it is computed,
+ * encoding every value against its prediction from the previous ones.
+ * Records are gathered in a fixed buffer, which is written out
+ * whenever it is almost full, so nothing is allocated per point.
+ *
+ * It is also a SolutionSink, which flushes the stream when finished.
+ * With the kDerivative predictor, points added without derivative
+ * are stored with a zero derivative.
+ */
+template <int N>
+class CompressedTrajectoryWriter {
+ public:
+  static constexpr int kDim = N;
+  static constexpr size_t kBufferBytes = 1 << 16;
+
+  /**
+   * Starts a stream. A tolerance of 0 makes it lossless.
+   */
+  CompressedTrajectoryWriter(std::ostream& out,
+      TrajectoryPredictor predictor = TrajectoryPredictor::kLinear,
+      double tolerance = 0)
+    : out_(out), predictor_(predictor), tolerance_(tolerance),
+      buffer_(kBufferBytes) {
+    CompressedTrajectoryHeader header{};
+    std::memcpy(header.magic, CompressedTrajectoryHeader::kMagic, 8);
+    header.version = CompressedTrajectoryHeader::kVersion;
+    header.dim = N;
+    header.predictor = static_cast<uint32_t>(predictor);
+    header.tolerance = tolerance;
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+
+  CompressedTrajectoryWriter(const CompressedTrajectoryWriter&) = delete;
+  CompressedTrajectoryWriter& operator=(const CompressedTrajectoryWriter&)
+      = delete;
+  ~CompressedTrajectoryWriter() { flush(); }
+
+  inline size_t size() const { return size_; }
+  // Bytes written so far, including those still in the buffer
+  inline size_t bytes() const {
+    return written_ + (end_ - buffer_.data()) +
+        sizeof(CompressedTrajectoryHeader);
+  }
+
+  inline void addPoint(double t, const Vectord<N>& x) {
+    addPoint(t, x, Vectord<N>::Zero());
+  }
+
+  void addPoint(double t, const Vectord<N>& x, const Vectord<N>& dv) {
+    using namespace compression;
+    if (end_ + kMaxRecordBytes > buffer_.data() + buffer_.size()) {
+      flush();
+    }
+    end_ = PutXor(end_, t, state_.time());
+    Vectord<N> p = state_.point(t);
+    Vectord<N> xd = x;
+    Vectord<N> dvd = dv;
+    for (int i = 0; i < N; ++i) {
+      end_ = tolerance_ > 0? PutQuantized(end_, x[i], p[i], tolerance_, xd[i])
+          : PutXor(end_, x[i], p[i]);
+    }
+    if (predictor_ == TrajectoryPredictor::kDerivative) {
+      Vectord<N> pdv = state_.derivative();
+      for (int i = 0; i < N; ++i) {
+        end_ = tolerance_ > 0?
+            PutQuantized(end_, dv[i], pdv[i], tolerance_, dvd[i]) :
+            PutXor(end_, dv[i], pdv[i]);
+      }
+    }
+    state_.push(t, xd, dvd);
+    ++size_;
+  }
+
+  /**
+   * Writes the buffered records to the output stream.
+   */
+  bool flush() {
+    size_t n = end_ - buffer_.data();
+    out_.write(reinterpret_cast<const char*>(buffer_.data()), n);
+    written_ += n;
+    end_ = buffer_.data();
+    if (!out_) {
+      std::cerr << "CompressedTrajectoryWriter: cannot write" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  inline void onPointAccepted(double t, const Vectord<N>& x) {
+    addPoint(t, x);
+  }
+
+  inline void onStepRejected(double t, double h) {}
+
+  inline void onFinished(SolverResult result) {
+    flush();
+    out_.flush();
+  }
+
+ private:
+  static constexpr size_t kMaxRecordBytes =
+      (1 + 2*N)*compression::kMaxValueBytes;
+
+  std::ostream& out_;
+  TrajectoryPredictor predictor_;
+  double tolerance_;
+  compression::PointPredictor<N> state_{predictor_};
+  std::vector<uint8_t> buffer_;
+  uint8_t* end_ = buffer_.data();
+  size_t written_ = 0;
+  size_t size_ = 0;
+};
+
+/**
+ * CompressedTrajectoryReader
+ *
+ * Decodes, one point at a time, a stream written by
+ * a CompressedTrajectoryWriter of the same dimension.
+ */
+template <int N>
+class CompressedTrajectoryReader {
+ public:
+  static constexpr int kDim = N;
+  static constexpr size_t kBufferBytes = 1 << 16;
+
+  explicit CompressedTrajectoryReader(std::istream& in)
+    : in_(in), buffer_(kBufferBytes) {
+    CompressedTrajectoryHeader header;
+    in_.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in_ || std::memcmp(header.magic, CompressedTrajectoryHeader::kMagic,
+        8) != 0 || header.version != CompressedTrajectoryHeader::kVersion
+        || header.dim != N || header.predictor > static_cast<uint32_t>(
+            TrajectoryPredictor::kDerivative)) {
+      std::cerr << "CompressedTrajectoryReader: not a compressed trajectory"
+          << " of dimension " << N << std::endl;
+      return;
+    }
+    valid_ = true;
+    predictor_ = static_cast<TrajectoryPredictor>(header.predictor);
+    tolerance_ = header.tolerance;
+    state_ = compression::PointPredictor<N>(predictor_);
+  }
+
+  inline bool valid() const { return valid_; }
+  inline TrajectoryPredictor predictor() const { return predictor_; }
+  inline double tolerance() const { return tolerance_; }
+  inline bool hasDerivatives() const {
+    return predictor_ == TrajectoryPredictor::kDerivative;
+  }
+
+  /**
+   * Decodes the next point.
+   * Returns false at the end of the stream or if it is truncated.
+   * dv is only decoded if the stream has derivatives.
+   */
+  bool next(double& t, Vectord<N>& x, Vectord<N>& dv) {
+    using namespace compression;
+    if (!valid_ || !fill()) {
+      return false;
+    }
+    const uint8_t* in = begin_;
+    in = GetXor(in, state_.time(), t);
+    Vectord<N> p = state_.point(t);
+    for (int i = 0; i < N; ++i) {
+      in = tolerance_ > 0? GetQuantized(in, p[i], tolerance_, x[i]) :
+          GetXor(in, p[i], x[i]);
+    }
+    dv.setZero();
+    if (hasDerivatives()) {
+      Vectord<N> pdv = state_.derivative();
+      for (int i = 0; i < N; ++i) {
+        in = tolerance_ > 0? GetQuantized(in, pdv[i], tolerance_, dv[i]) :
+            GetXor(in, pdv[i], dv[i]);
+      }
+    }
+    if (in > end_) {
+      std::cerr << "CompressedTrajectoryReader: truncated stream" << std::endl;
+      valid_ = false;
+      return false;
+    }
+    begin_ += in - begin_;
+    state_.push(t, x, dv);
+    return true;
+  }
+
+  inline bool next(double& t, Vectord<N>& x) {
+    Vectord<N> dv;
+    return next(t, x, dv);
+  }
+
+ private:
+  static constexpr size_t kMaxRecordBytes =
+      (1 + 2*N)*compression::kMaxValueBytes;
+
+  // Makes sure a whole record is buffered, unless the stream ends.
+  // Returns whether any byte is left.
+  bool fill() {
+    size_t left = end_ - begin_;
+    if (left < kMaxRecordBytes && in_) {
+      if (left > 0) {
+        std::memmove(buffer_.data(), begin_, left);
+      }
+      in_.read(reinterpret_cast<char*>(buffer_.data() + left),
+          buffer_.size() - left - kMaxRecordBytes);
+      begin_ = buffer_.data();
+      end_ = begin_ + left + in_.gcount();
+      // Zero padding so that truncated records are never read past
+      std::memset(end_, 0, kMaxRecordBytes);
+    }
+    return begin_ < end_;
+  }
+
+  std::istream& in_;
+  bool valid_ = false;
+  TrajectoryPredictor predictor_ = TrajectoryPredictor::kPrevious;
+  double tolerance_ = 0;
+  compression::PointPredictor<N> state_{predictor_};
+  std::vector<uint8_t> buffer_;
+  uint8_t* begin_ = nullptr;
+  uint8_t* end_ = nullptr;
+};
+
+/**
+ * Appends every point of a compressed trajectory to a solution.
+ * Returns the number of points added, which is smaller than the number
+ * in the stream if the solution cannot grow. See ResizeSolution.
+ */
+template <OdeSolution Sol>
+size_t ReadCompressedTrajectory(std::istream& in, Sol& sol) {
+  CompressedTrajectoryReader<Sol::kDim> reader(in);
+  double t;
+  Vectord<Sol::kDim> x, dv;
+  size_t n = 0;
+  while (reader.next(t, x, dv)) {
+    bool added = reader.hasDerivatives()? AddSolutionPoint(sol, t, x, dv) :
+        AddSolutionPoint(sol, t, x);
+    if (!added) {
+      break;
+    }
+    ++n;
+  }
+  return n;
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_TOOLS_COMPRESSED_TRAJECTORY_HPP_
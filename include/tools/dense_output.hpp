@@ -0,0 +1,194 @@
+#ifndef INCLUDE_TOOLS_DENSE_OUTPUT_HPP_
+#define INCLUDE_TOOLS_DENSE_OUTPUT_HPP_
+
+#include <cmath>
+#include <optional>
+#include "initial_value_problem.hpp"
+#include "methods/interfaces/dense_output_method.hpp"
+#include "ode_solution.hpp"
+#include "tools/interpolation.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * The cubic Hermite interpolant of a step,
+ * built from the points and derivatives at both of its ends.
+ * Its error is O(h^4) inside the step.
+ */
+template <int N>
+struct HermiteInterpolant {
+  inline Vectord<N> operator()(double t) const {
+    return interpolation::CubicHermite(t0, x0, dv0, t0 + h, x1, dv1, t);
+  }
+
+  double t0;
+  double h;
+  Vectord<N> x0;
+  Vectord<N> x1;
+  Vectord<N> dv0;
+  Vectord<N> dv1;
+};
+
+/**
+ * DenseOutput
+ *
+ * Evaluates an OdeSolution at any time between its first and last point
+ * by locating the step that contains it and evaluating an interpolant
+ * of that step: the cubic Hermite interpolant of its ends,
+ * or the continuous extension of the method that computed it.
+ * Nothing is allocated per evaluation.
+ *
+ * When the solution was computed with a fixed step size,
+ * the step is found arithmetically instead of by binary search.
+ * The solution must outlive the DenseOutput and not change meanwhile.
+ */
+template <OdeSolution Os>
+class DenseOutput {
+ public:
+  static constexpr int kDim = Os::kDim;
+
+  /**
+   * Checks whether the solution is uniformly stepped,
+   * with every time within relTol steps of its expected value.
+   */
+  explicit DenseOutput(const Os& os, double relTol = 1e-6) : os_(os) {
+    size_t n = os.size();
+    if (n < 2) {
+      return;
+    }
+    t0_ = os.t[0];
+    h_ = (os.t[n-1] - t0_)/(n-1);
+    uniform_ = h_ > 0;
+    for (size_t i = 1; i < n && uniform_; ++i) {
+      uniform_ = std::abs(os.t[i] - (t0_ + i*h_)) <= relTol*h_;
+    }
+  }
+
+  inline bool uniform() const { return uniform_; }
+
+  /**
+   * Returns the index i of the step [t[i], t[i+1]] that contains time.
+   */
+  std::optional<size_t> findStep(double time) const {
+    size_t n = os_.size();
+    if (n < 2 || !(time >= os_.t[0] && time <= os_.t[n-1])) {
+      return {};
+    }
+    size_t i;
+    if (uniform_) {
+      double pos = std::floor((time - t0_)/h_);
+      i = std::min(static_cast<size_t>(std::max(pos, 0.0)), n-2);
+      // Correct the rounding of the division
+      while (i > 0 && os_.t[i] > time) {
+        --i;
+      }
+      while (i+2 < n && os_.t[i+1] < time) {
+        ++i;
+      }
+    } else {
+      i = LowerBoundTime(os_, time);
+      i = i > 0? i-1 : 0;
+    }
+    return i;
+  }
+
+  /**
+   * Returns the cubic Hermite interpolant of the i-th step,
+   * which needs the solution to contain its derivatives.
+   */
+  inline HermiteInterpolant<kDim> interpolant(size_t i) const
+      requires Os::kStoresDerivatives {
+    return {os_.t[i], os_.t[i+1] - os_.t[i], os_.x[i], os_.x[i+1],
+        os_.dv[i], os_.dv[i+1]};
+  }
+
+  /**
+   * Returns the cubic Hermite interpolant of the i-th step,
+   * evaluating the derivatives that are not stored.
+   */
+  template <IvpDerivative D>
+  inline HermiteInterpolant<kDim> interpolant(size_t i, const D& f) const {
+    HermiteInterpolant<kDim> in{os_.t[i], os_.t[i+1] - os_.t[i], os_.x[i],
+        os_.x[i+1]};
+    derivatives(i, f, in.dv0, in.dv1);
+    return in;
+  }
+
+  /**
+   * Returns the continuous extension of the method for the i-th step.
+   * Its stages are recomputed from the start of the step.
+   */
+  template <typename Met, IvpDerivative D>
+  requires DenseOutputMethod<Met, D>
+  inline auto interpolant(size_t i, const Met& met, const D& f) const {
+    Vectord<kDim> dv0, dv1;
+    derivatives(i, f, dv0, dv1);
+    return met.interpolant(f, os_.t[i], Vectord<kDim>(os_.x[i]), dv0,
+        os_.t[i+1] - os_.t[i], dv1);
+  }
+
+  /**
+   * Interpolates with the stored derivatives.
+   * Returns nothing outside the solution or if it lacks derivatives.
+   */
+  std::optional<Vectord<kDim>> operator()(double time) const
+      requires Os::kStoresDerivatives {
+    auto i = findStep(time);
+    if (!i || !os_.containsDerivatives()) {
+      return {};
+    }
+    return interpolant(*i)(time);
+  }
+
+  /**
+   * Interpolates with cubic Hermite, evaluating missing derivatives with f.
+   */
+  template <IvpDerivative D>
+  std::optional<Vectord<kDim>> operator()(double time, const D& f) const {
+    auto i = findStep(time);
+    if (!i) {
+      return {};
+    }
+    return interpolant(*i, f)(time);
+  }
+
+  /**
+   * Interpolates with the continuous extension of the method
+   * that computed the solution.
+   */
+  template <typename Met, IvpDerivative D>
+  requires DenseOutputMethod<Met, D>
+  std::optional<Vectord<kDim>> operator()(double time, const Met& met,
+      const D& f) const {
+    auto i = findStep(time);
+    if (!i) {
+      return {};
+    }
+    return interpolant(*i, met, f)(time);
+  }
+
+ private:
+  template <IvpDerivative D>
+  inline void derivatives(size_t i, const D& f, Vectord<kDim>& dv0,
+      Vectord<kDim>& dv1) const {
+    if constexpr (Os::kStoresDerivatives) {
+      if (os_.containsDerivatives()) {
+        dv0 = os_.dv[i];
+        dv1 = os_.dv[i+1];
+        return;
+      }
+    }
+    dv0 = f(os_.t[i], os_.x[i]);
+    dv1 = f(os_.t[i+1], os_.x[i+1]);
+  }
+
+  const Os& os_;
+  double t0_ = 0;
+  double h_ = 0;
+  bool uniform_ = false;
+};
+
+}  // namespace odelib
+
+#endif  // INCLUDE_TOOLS_DENSE_OUTPUT_HPP_
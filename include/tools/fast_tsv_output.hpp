@@ -0,0 +1,218 @@
+#ifndef INCLUDE_TOOLS_FAST_TSV_OUTPUT_HPP_
+#define INCLUDE_TOOLS_FAST_TSV_OUTPUT_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <charconv>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ode_solution.hpp"
+
+namespace odelib {
+
+namespace tsv {
+
+/** Rows formatted by each task. */
+constexpr size_t kChunkRows = 8192;
+/** Longest shortest round-trip representation of a double. */
+constexpr size_t kMaxDoubleChars = 24;
+
+/**
+ * Number of points that PrintSolution selects out of n
+ * when printing at most maxNum of them.
+ */
+inline size_t SelectedRows(size_t n, int maxNum) {
+  if (n == 0) return 0;
+  size_t m = std::max(maxNum, 0);
+  if (m >= n) return n;
+  return (n-1)*m/n + 1;
+}
+
+/**
+ * Index of the k-th point that PrintSolution selects out of n,
+ * that is, the first i with i*maxNum >= k*n.
+ */
+inline size_t SelectedRow(size_t k, size_t n, int maxNum) {
+  size_t m = std::max(maxNum, 0);
+  if (m >= n) return k;
+  if (m == 0) return 0;
+  return (k*n + m - 1)/m;
+}
+
+inline char* PutDouble(char* out, double v) {
+  return std::to_chars(out, out + kMaxDoubleChars, v).ptr;
+}
+
+/**
+ * Formats the selected rows [k0, k1) of a solution into buf,
+ * replacing its contents.
+ */
+template <OdeSolution Sol>
+void FormatRows(std::vector<char>& buf, const Sol& sol,
+    const std::vector<int>& indices, bool withTime, int maxNum, size_t k0,
+    size_t k1) {
+  size_t cols = indices.size() + withTime;
+  buf.resize((k1 - k0)*cols*(kMaxDoubleChars + 1));
+  char* p = buf.data();
+  size_t n = sol.size();
+  for (size_t k = k0; k < k1; ++k) {
+    size_t i = SelectedRow(k, n, maxNum);
+    if (withTime) {
+      p = PutDouble(p, sol.t[i]);
+      *p++ = '\t';
+    }
+    for (int id : indices) {
+      p = PutDouble(p, sol.x[i][id]);
+      *p++ = '\t';
+    }
+    p[-1] = '\n';
+  }
+  buf.resize(p - buf.data());
+}
+
+/**
+ * Formats the selected rows in chunks of kChunkRows,
+ * with up to threads workers, and writes each chunk in order
+ * with a single write.
+ * Workers stay at most two chunks each ahead of the output.
+ */
+template <OdeSolution Sol>
+void Print(std::ostream& out, const Sol& sol, const std::vector<int>& indices,
+    bool withTime, int maxNum, unsigned threads) {
+  size_t rows = SelectedRows(sol.size(), maxNum);
+  size_t chunks = (rows + kChunkRows - 1)/kChunkRows;
+  threads = std::min<size_t>(std::max(threads, 1u), chunks);
+  if (threads <= 1) {
+    std::vector<char> buf;
+    for (size_t c = 0; c < chunks && out; ++c) {
+      FormatRows(buf, sol, indices, withTime, maxNum, c*kChunkRows,
+          std::min(rows, (c+1)*kChunkRows));
+      out.write(buf.data(), buf.size());
+    }
+    return;
+  }
+
+  struct Slot {
+    std::vector<char> buf;
+    size_t chunk = -1;
+  };
+  size_t numSlots = 2*threads;
+  std::vector<Slot> slots(numSlots);
+  std::atomic<size_t> next = 0;
+  size_t written = 0;
+  bool failed = false;
+  std::mutex mutex;
+  std::condition_variable cv;
+
+  auto work = [&]() {
+    for (size_t c; (c = next.fetch_add(1)) < chunks;) {
+      {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&]() { return c < written + numSlots || failed; });
+        if (failed) return;
+      }
+      // The slot is not used by anyone else until chunk c is written
+      Slot& slot = slots[c % numSlots];
+      FormatRows(slot.buf, sol, indices, withTime, maxNum, c*kChunkRows,
+          std::min(rows, (c+1)*kChunkRows));
+      {
+        std::lock_guard lock(mutex);
+        slot.chunk = c;
+      }
+      cv.notify_all();
+    }
+  };
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < threads; ++i) {
+    workers.emplace_back(work);
+  }
+
+  for (size_t c = 0; c < chunks; ++c) {
+    Slot& slot = slots[c % numSlots];
+    {
+      std::unique_lock lock(mutex);
+      cv.wait(lock, [&]() { return slot.chunk == c; });
+    }
+    out.write(slot.buf.data(), slot.buf.size());
+    {
+      std::lock_guard lock(mutex);
+      ++written;
+      failed = !out;
+    }
+    cv.notify_all();
+    if (!out) break;
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+}  // namespace tsv
+
+/**
+ * Prints the desired indices of a solution with tsv format,
+ * selecting the same points as PrintSolution.
+ * Values are printed with their shortest round-trip representation,
+ * so they are read back exactly.
+ * The rows are formatted in parallel by up to threads workers.
+ */
+template <OdeSolution Sol>
+void FastPrintSolution(std::ostream& out, const Sol& sol,
+    const std::vector<int>& indices, int maxNum = 1e4,
+    unsigned threads = std::thread::hardware_concurrency()) {
+  assert(!indices.empty());
+  if (sol.empty()) return;
+  for (int id : indices) {
+    assert(0 <= id && id < (int) sol.x[0].size());
+  }
+  tsv::Print(out, sol, indices, false, maxNum, threads);
+}
+
+/**
+ * Prints the time and the desired indices of a solution with tsv format,
+ * selecting the same points as PrintSolutionWithTime.
+ * Values are printed with their shortest round-trip representation,
+ * so they are read back exactly.
+ * The rows are formatted in parallel by up to threads workers.
+ */
+template <OdeSolution Sol>
+void FastPrintSolutionWithTime(std::ostream& out, const Sol& sol,
+    const std::vector<int>& indices, int maxNum = 1e4,
+    unsigned threads = std::thread::hardware_concurrency()) {
+  if (sol.empty()) return;
+  for (int id : indices) {
+    assert(0 <= id && id < (int) sol.x[0].size());
+  }
+  tsv::Print(out, sol, indices, true, maxNum, threads);
+}
+
+template <OdeSolution Sol>
+void FastPrintSolution(std::ostream& out, const Sol& sol, int maxNum = 1e4,
+    unsigned threads = std::thread::hardware_concurrency()) {
+  if (sol.empty()) return;
+  std::vector<int> ind(sol.x[0].size());
+  for (int i = 0; i < sol.x[0].size(); ++i) {
+    ind[i] = i;
+  }
+  FastPrintSolution(out, sol, ind, maxNum, threads);
+}
+
+template <OdeSolution Sol>
+void FastPrintSolutionWithTime(std::ostream& out, const Sol& sol,
+    int maxNum = 1e4,
+    unsigned threads = std::thread::hardware_concurrency()) {
+  if (sol.empty()) return;
+  std::vector<int> ind(sol.x[0].size());
+  for (int i = 0; i < sol.x[0].size(); ++i) {
+    ind[i] = i;
+  }
+  FastPrintSolutionWithTime(out, sol, ind, maxNum, threads);
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_TOOLS_FAST_TSV_OUTPUT_HPP_
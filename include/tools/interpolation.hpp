@@ -2,7 +2,9 @@
 #define INCLUDE_TOOLS_INTERPOLATION_HPP_
 
 #include <algorithm>
+#include <array>
 #include <vector>
+#include "tools/unroll.hpp"
 #include "types.hpp"
 
 namespace odelib {
@@ -10,35 +12,204 @@ namespace odelib {
 namespace interpolation {
 
 /**
- * Interpolates a function from R to R^n for which we know f(x[i]) = y[i]
- * at the point x0.
+ * Largest number of nodes with a kernel unrolled at compile time.
+ */
+constexpr int kMaxUnrolledNodes = 8;  // See Hermite
+
+/**
+ * Computes the coefficients of the Newton form of the polynomial
+ * that interpolates the K given nodes, c[i] = f[x[0], ..., x[i]].
+ */
+template <int K, int N>
+std::array<Vectord<N>, K> NewtonCoefficients(const double* x,
+    const Vectord<N>* y) {
+  std::array<Vectord<N>, K> c;
+  Unroll<K>([&](auto i) { c[i] = y[i]; });
+  Unroll<K-1>([&](auto i1) {
+    constexpr int i = i1 + 1;
+    Unroll<K-i>([&](auto jj) {
+      constexpr int j = K-1 - jj;
+      c[j] = (c[j] - c[j-1]) * (1 / (x[j] - x[j-i]));
+    });
+  });
+  return c;
+}
+
+template <int K, int N>
+std::array<Vectord<N>, K> NewtonCoefficients(const std::array<double, K>& x,
+    const std::array<Vectord<N>, K>& y) {
+  return NewtonCoefficients<K, N>(x.data(), y.data());
+}
+
+/**
+ * Evaluates at x0 the Newton form with the K given nodes and coefficients.
+ */
+template <int K, int N>
+Vectord<N> EvaluateNewton(const double* x,
+    const std::array<Vectord<N>, K>& c, double x0) {
+  Vectord<N> y0 = c[K-1];
+  Unroll<K-1>([&](auto ii) {
+    constexpr int i = K-2 - ii;
+    y0 = c[i] + (x0 - x[i])*y0;
+  });
+  return y0;
+}
+
+template <int K, int N>
+Vectord<N> EvaluateNewton(const std::array<double, K>& x,
+    const std::array<Vectord<N>, K>& c, double x0) {
+  return EvaluateNewton<K, N>(x.data(), c, x0);
+}
+
+/**
+ * Interpolates a function from R to R^n for which we know f(x[i]) = y[i],
+ * for the K given nodes, at the point x0, with divided differences.
+ */
+template <int K, int N>
+Vectord<N> Newton(const double* x, const Vectord<N>* y, double x0) {
+  return EvaluateNewton<K, N>(x, NewtonCoefficients<K, N>(x, y), x0);
+}
+
+template <int K, int N>
+Vectord<N> Newton(const std::array<double, K>& x,
+    const std::array<Vectord<N>, K>& y, double x0) {
+  return Newton<K, N>(x.data(), y.data(), x0);
+}
+
+/**
+ * Computes the barycentric weights of the K given nodes,
+ * w[j] = 1 / prod_{k != j} (x[j] - x[k]).
+ * They only depend on the nodes, so they can be reused for any values.
+ */
+template <int K>
+std::array<double, K> BarycentricWeights(const std::array<double, K>& x) {
+  std::array<double, K> w;
+  Unroll<K>([&](auto j) {
+    double p = 1;
+    Unroll<K>([&](auto k) {
+      if constexpr (j != k) {
+        p *= x[j] - x[k];
+      }
+    });
+    w[j] = 1/p;
+  });
+  return w;
+}
+
+/**
+ * Interpolates a function from R to R^n for which we know f(x[i]) = y[i],
+ * for the K given nodes with barycentric weights w,
+ * at the point x0, with the barycentric Lagrange formula.
+ */
+template <int K, int N>
+Vectord<N> Barycentric(const std::array<double, K>& x,
+    const std::array<double, K>& w, const std::array<Vectord<N>, K>& y,
+    double x0) {
+  Vectord<N> num = Vectord<N>::Zero();
+  double den = 0;
+  int exact = -1;
+  Unroll<K>([&](auto j) {
+    double d = x0 - x[j];
+    if (d == 0) {
+      exact = j;
+    }
+    double c = w[j]/d;
+    num += c*y[j];
+    den += c;
+  });
+  if (exact >= 0) {
+    return y[exact];
+  }
+  return num/den;
+}
+
+template <int K, int N>
+Vectord<N> Barycentric(const std::array<double, K>& x,
+    const std::array<Vectord<N>, K>& y, double x0) {
+  return Barycentric<K, N>(x, BarycentricWeights<K>(x), y, x0);
+}
+
+/**
+ * Interpolates a function from R to R^n at the point x0
+ * with the cubic polynomial that takes the values y0, y1
+ * and has derivatives dy0, dy1 at x0 and x1.
  */
 template <int N>
-Vectord<N> Hermite(const std::vector<double>& x,
-    const std::vector<Vectord<N>>& y, double x0) {
-  int sz = x.size();
-  Vectord<N> diff_table[sz][sz];
-  std::copy(y.begin(), y.end(), diff_table[0]);
+Vectord<N> CubicHermite(double x0, const Vectord<N>& y0,
+    const Vectord<N>& dy0, double x1, const Vectord<N>& y1,
+    const Vectord<N>& dy1, double x) {
+  double h = x1 - x0;
+  double th = (x - x0)/h;
+  double th2 = th*th;
+  double th3 = th2*th;
+  return (2*th3 - 3*th2 + 1)*y0 + (-2*th3 + 3*th2)*y1
+      + h*((th3 - 2*th2 + th)*dy0 + (th3 - th2)*dy1);
+}
+
+/**
+ * Interpolates a function from R to R^n at the point x0
+ * with the quintic polynomial that takes the values y0, y1
+ * and has first derivatives dy0, dy1 and second derivatives ddy0, ddy1
+ * at x0 and x1.
+ */
+template <int N>
+Vectord<N> QuinticHermite(double x0, const Vectord<N>& y0,
+    const Vectord<N>& dy0, const Vectord<N>& ddy0, double x1,
+    const Vectord<N>& y1, const Vectord<N>& dy1, const Vectord<N>& ddy1,
+    double x) {
+  double h = x1 - x0;
+  double th = (x - x0)/h;
+  double th2 = th*th;
+  double th3 = th2*th;
+  // th^3 (a + b th + c th^2) for each basis polynomial
+  auto cubic = [&](double a, double b, double c) {
+    return th3*(a + th*(b + th*c));
+  };
+  return (1 + cubic(-10, 15, -6))*y0 + cubic(10, -15, 6)*y1
+      + h*((th + cubic(-6, 8, -3))*dy0 + cubic(-4, 7, -3)*dy1)
+      + h*h*((th2/2 + cubic(-1.5, 1.5, -0.5))*ddy0
+          + cubic(0.5, -1, 0.5)*ddy1);
+}
 
+/**
+ * Interpolates a function from R to R^n for which we know f(x[i]) = y[i],
+ * for the sz given nodes, at the point x0.
+ * Up to kMaxUnrolledNodes nodes it dispatches to the unrolled Newton kernel.
+ * Earlier versions did not pass through the nodes, see CHANGELOG.md.
+ */
+template <int N>
+Vectord<N> Hermite(const double* x, const Vectord<N>* y, int sz, double x0) {
+  switch (sz) {
+    case 1: return y[0];
+    case 2: return Newton<2, N>(x, y, x0);
+    case 3: return Newton<3, N>(x, y, x0);
+    case 4: return Newton<4, N>(x, y, x0);
+    case 5: return Newton<5, N>(x, y, x0);
+    case 6: return Newton<6, N>(x, y, x0);
+    case 7: return Newton<7, N>(x, y, x0);
+    case 8: return Newton<8, N>(x, y, x0);
+  }
+  std::vector<Vectord<N>> c(y, y + sz);
   for (int i = 1; i < sz; ++i) {
-    for (int j = i; j < sz; ++j) {
-      diff_table[i][j] =
-        (diff_table[i-1][j] - diff_table[i-1][j-1]) / (x[j] - x[j-i]);
+    for (int j = sz-1; j >= i; --j) {
+      c[j] = (c[j] - c[j-1]) / (x[j] - x[j-i]);
     }
   }
-
-  Vectord<N> y0{};
-  double s = 1;
-  for (int i = 0; i < sz; ++i) {
-    y0 += s*diff_table[i][sz-1];
-    s *= x0 - x[i];
+  Vectord<N> y0 = c[sz-1];
+  for (int i = sz-2; i >= 0; --i) {
+    y0 = c[i] + (x0 - x[i])*y0;
   }
   return y0;
 }
 
+template <int N>
+Vectord<N> Hermite(const std::vector<double>& x,
+    const std::vector<Vectord<N>>& y, double x0) {
+  return Hermite(x.data(), y.data(), x.size(), x0);
+}
+
 }  // namespace interpolation
 
 }  // namespace odelib
 
 #endif  // INCLUDE_TOOLS_INTERPOLATION_HPP_
-
@@ -0,0 +1,79 @@
+#ifndef INCLUDE_TOOLS_JACOBIAN_HPP_
+#define INCLUDE_TOOLS_JACOBIAN_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "initial_value_problem.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * The forward difference approximation of the Jacobian of f
+ * with respect to x at (t, x), given fx = f(t, x).
+ * Costs one evaluation per dimension.
+ */
+template <IvpDerivative D>
+Matrixd<D::kDim, D::kDim> FiniteDifferenceJacobian(const D& f, double t,
+    const Vectord<D::kDim>& x, const Vectord<D::kDim>& fx) {
+  Matrixd<D::kDim, D::kDim> jac(x.size(), x.size());
+  for (int j = 0; j < x.size(); ++j) {
+    double dx = std::sqrt(std::numeric_limits<double>::epsilon())
+        * std::max(std::abs(x[j]), 1e-5);
+    Vectord<D::kDim> y = x;
+    y[j] += dx;
+    jac.col(j) = (f(t, y) - fx)/dx;
+  }
+  return jac;
+}
+
+/**
+ * The Jacobian of f with respect to x at (t, x): the one of the problem
+ * if it is a SpaceDerivableIvpDerivative, and a finite difference
+ * approximation otherwise.
+ */
+template <IvpDerivative D>
+inline Matrixd<D::kDim, D::kDim> Jacobian(const D& f, double t,
+    const Vectord<D::kDim>& x) {
+  if constexpr (SpaceDerivableIvpDerivative<D>) {
+    return f.pdvx(t, x);
+  } else {
+    return FiniteDifferenceJacobian(f, t, x, f(t, x));
+  }
+}
+
+/**
+ * The Jacobian of f at (t, x), given fx = f(t, x)
+ * for the finite difference approximation.
+ */
+template <IvpDerivative D>
+inline Matrixd<D::kDim, D::kDim> Jacobian(const D& f, double t,
+    const Vectord<D::kDim>& x, const Vectord<D::kDim>& fx) {
+  if constexpr (SpaceDerivableIvpDerivative<D>) {
+    return f.pdvx(t, x);
+  } else {
+    return FiniteDifferenceJacobian(f, t, x, fx);
+  }
+}
+
+/**
+ * The derivative of f with respect to t at (t, x), given fx = f(t, x):
+ * the one of the problem if it is a TimeDerivableIvpDerivative,
+ * and a forward difference, which costs one evaluation, otherwise.
+ */
+template <IvpDerivative D>
+inline Vectord<D::kDim> TimeDerivative(const D& f, double t,
+    const Vectord<D::kDim>& x, const Vectord<D::kDim>& fx) {
+  if constexpr (TimeDerivableIvpDerivative<D>) {
+    return f.pdvt(t, x);
+  } else {
+    double dt = std::sqrt(std::numeric_limits<double>::epsilon()
+        * std::max(std::abs(t), 1e-5));
+    return (f(t + dt, x) - fx)/dt;
+  }
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_TOOLS_JACOBIAN_HPP_
@@ -0,0 +1,53 @@
+#ifndef INCLUDE_TOOLS_POLYNOMIAL_HPP_
+#define INCLUDE_TOOLS_POLYNOMIAL_HPP_
+
+#include <array>
+#include <cstddef>
+
+namespace odelib {
+
+/**
+ * Polynomials of degree below M, by their coefficients
+ * in increasing degree, for building the coefficients of the methods.
+ */
+template <size_t M>
+using Polynomial = std::array<double, M>;
+
+/**
+ * Returns p(x)*(a + b x). The coefficient of degree M is lost.
+ */
+template <size_t M>
+constexpr Polynomial<M> MultiplyByLinear(const Polynomial<M>& p, double a,
+    double b) {
+  Polynomial<M> q{};
+  for (size_t j = 0; j < M; ++j) {
+    q[j] = a*p[j] + (j > 0? b*p[j-1] : 0);
+  }
+  return q;
+}
+
+/**
+ * Returns the primitive of p that vanishes at 0.
+ * The coefficient of degree M is lost.
+ */
+template <size_t M>
+constexpr Polynomial<M> Primitive(const Polynomial<M>& p) {
+  Polynomial<M> q{};
+  for (size_t j = 1; j < M; ++j) {
+    q[j] = p[j-1]/j;
+  }
+  return q;
+}
+
+template <size_t M>
+constexpr double Evaluate(const Polynomial<M>& p, double x) {
+  double y = 0;
+  for (size_t j = M; j-- > 0;) {
+    y = y*x + p[j];
+  }
+  return y;
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_TOOLS_POLYNOMIAL_HPP_
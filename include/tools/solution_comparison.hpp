@@ -0,0 +1,177 @@
+#ifndef INCLUDE_TOOLS_SOLUTION_COMPARISON_HPP_
+#define INCLUDE_TOOLS_SOLUTION_COMPARISON_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "ode_solution.hpp"
+#include "tools/batch_interpolation.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * The differences between two solutions at the points compared.
+ */
+template <int N>
+struct SolutionDifference {
+  /** Maximum norm of the difference. */
+  double max = 0;
+  /** Mean norm of the difference. */
+  double mean = 0;
+  /** Root mean square of the norm of the difference. */
+  double rms = 0;
+  /** Maximum absolute difference of each component. */
+  Vectord<N> maxComponent = Vectord<N>::Zero();
+  /** Number of points compared. */
+  size_t count = 0;
+};
+
+namespace comparison {
+
+/**
+ * Running sums of the differences, which can be merged.
+ */
+template <int N>
+struct Accumulator {
+  inline void add(const Vectord<N>& diff) {
+    double norm = diff.norm();
+    max = std::max(max, norm);
+    sum += norm;
+    sumSquares += norm*norm;
+    maxComponent = maxComponent.cwiseMax(diff.cwiseAbs());
+    ++count;
+  }
+
+  inline void merge(const Accumulator& other) {
+    max = std::max(max, other.max);
+    sum += other.sum;
+    sumSquares += other.sumSquares;
+    maxComponent = maxComponent.cwiseMax(other.maxComponent);
+    count += other.count;
+  }
+
+  double max = 0;
+  double sum = 0;
+  double sumSquares = 0;
+  Vectord<N> maxComponent = Vectord<N>::Zero();
+  size_t count = 0;
+};
+
+/**
+ * Compares the points [i0, i1) of lhs with rhs interpolated at their times.
+ * Both time grids are walked forwards together, like in a merge.
+ * The points outside rhs are skipped.
+ */
+template <OdeSolution Os1, OdeSolution Os2>
+void CompareRange(const Os1& lhs, const Os2& rhs, size_t i0, size_t i1,
+    Accumulator<Os1::kDim>& acc) {
+  size_t m = rhs.size();
+  if (m == 0 || i0 >= i1) {
+    return;
+  }
+  double tBegin = rhs.t[0];
+  double tEnd = rhs.t[m-1];
+  // Skip the points before rhs and compare the one at its start directly
+  size_t i = i0;
+  while (i < i1 && lhs.t[i] <= tBegin) {
+    if (lhs.t[i] == tBegin) {
+      acc.add(lhs.x[i] - rhs.x[0]);
+    }
+    ++i;
+  }
+  if (i == i1 || m < 2) {
+    return;
+  }
+  SweepInterpolator<Os2> interpolator(rhs, lhs.t[i], true);
+  for (; i < i1 && lhs.t[i] <= tEnd; ++i) {
+    acc.add(lhs.x[i] - interpolator(lhs.t[i]));
+  }
+}
+
+}  // namespace comparison
+
+/**
+ * Compares two solutions of the same problem in a single pass,
+ * interpolating each one at the times of the points of the other
+ * that lie within it, with the cubic Hermite interpolant of its steps
+ * if it contains derivatives.
+ *
+ * The solutions are taken by reference. Each solution is split
+ * into ranges of points that are compared by up to threads threads.
+ * With a single thread nothing is allocated. With more, only the threads
+ * and one partial result per thread are.
+ */
+template <OdeSolution Os1, OdeSolution Os2>
+requires (Os1::kDim == Os2::kDim)
+SolutionDifference<Os1::kDim> CompareSolutions(const Os1& lhs,
+    const Os2& rhs, unsigned threads = 1) {
+  constexpr int N = Os1::kDim;
+  // Small solutions are not worth a thread
+  constexpr size_t kMinPerThread = 1 << 14;
+  size_t total = lhs.size() + rhs.size();
+  threads = std::clamp<size_t>(total/kMinPerThread, 1, std::max(threads, 1u));
+
+  auto work = [&](unsigned k, comparison::Accumulator<N>& acc) {
+    comparison::CompareRange(lhs, rhs, lhs.size()*k/threads,
+        lhs.size()*(k+1)/threads, acc);
+    comparison::CompareRange(rhs, lhs, rhs.size()*k/threads,
+        rhs.size()*(k+1)/threads, acc);
+  };
+  comparison::Accumulator<N> acc;
+  if (threads == 1) {
+    work(0, acc);
+  } else {
+    std::vector<comparison::Accumulator<N>> partial(threads);
+    std::vector<std::thread> workers;
+    for (unsigned k = 1; k < threads; ++k) {
+      workers.emplace_back(work, k, std::ref(partial[k]));
+    }
+    work(0, partial[0]);
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    for (const auto& p : partial) {
+      acc.merge(p);
+    }
+  }
+  SolutionDifference<N> diff;
+  diff.max = acc.max;
+  diff.maxComponent = acc.maxComponent;
+  diff.count = acc.count;
+  if (acc.count > 0) {
+    diff.mean = acc.sum/acc.count;
+    diff.rms = std::sqrt(acc.sumSquares/acc.count);
+  }
+  return diff;
+}
+
+/**
+ * Returns the maximum difference between two OdeSolution.
+ *
+ * The algorithm interpolates at the time of
+ * each of the solution's points. See CompareSolutions.
+ */
+template <OdeSolution Os1, OdeSolution Os2>
+requires (Os1::kDim == Os2::kDim)
+double AbsDiff(const Os1& lhs, const Os2& rhs, unsigned threads = 1) {
+  return CompareSolutions(lhs, rhs, threads).max;
+}
+
+/**
+ * Returns the mean difference between two OdeSolution.
+ *
+ * The algorithm interpolates at the time of
+ * each of the solution's points. See CompareSolutions.
+ */
+template <OdeSolution Os1, OdeSolution Os2>
+requires (Os1::kDim == Os2::kDim)
+double MeanDiff(const Os1& lhs, const Os2& rhs, unsigned threads = 1) {
+  return CompareSolutions(lhs, rhs, threads).mean;
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_TOOLS_SOLUTION_COMPARISON_HPP_
@@ -0,0 +1,433 @@
+#ifndef INCLUDE_TOOLS_TRAJECTORY_FILE_HPP_
+#define INCLUDE_TOOLS_TRAJECTORY_FILE_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "ode_solution.hpp"
+#include "solutions/chunked_ode_solution.hpp"
+#include "solvers/types.hpp"
+#include "types.hpp"
+
+namespace odelib {
+
+/**
+ * Header of the binary trajectory files.
+ *
+ * The file is the 128 byte header followed by chunks of chunkRows points,
+ * laid out as in SolutionChunkFormat: the time column,
+ * the x block and, if the file has derivatives, the dv block.
+ * Every chunk has room for chunkRows points, even if the last one
+ * is not full (its unused rows are zero),
+ * so chunk c starts at byte 128 + c*chunkRows*8*(1 + N)
+ * or 128 + c*chunkRows*8*(1 + 2*N) with derivatives.
+ * All values are stored in the byte order of the machine that wrote them.
+ */
+struct TrajectoryFileHeader {
+  static constexpr char kMagic[8] = {'O', 'D', 'E', 'L', 'I', 'B', 'T', 'R'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kTagSize = 32;
+  // The file has a dv block in each chunk
+  static constexpr uint64_t kDerivatives = 1;
+  // Some point was written without its derivative
+  static constexpr uint64_t kMissingDerivatives = 2;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t dim;
+  uint32_t layout;     // a SolutionLayout
+  uint32_t chunkRows;
+  uint64_t size;       // number of points
+  uint64_t flags;
+  char method[kTagSize];   // null-terminated tags
+  char problem[kTagSize];
+  uint64_t reserved[3];
+};
+
+static_assert(sizeof(TrajectoryFileHeader) == 128);
+
+/**
+ * TrajectoryWriter
+ *
+ * Writes a trajectory to a binary trajectory file as it is computed.
+ * Points are gathered in a single chunk buffer,
+ * which is written to the file whenever it fills,
+ * so memory use is constant and the size in the header
+ * always counts the points of the complete chunks already written.
+ *
+ * It is also a SolutionSink, which closes the file when finished.
+ * Errors are logged to the standard error output
+ * and reported through the return values.
+ * Adding points to a writer that is not open fails.
+ */
+template <int N, SolutionLayout Layout = SolutionLayout::kSoA,
+    int ChunkRows = 4096>
+class TrajectoryWriter {
+ public:
+  using Format = SolutionChunkFormat<N, Layout, ChunkRows>;
+
+  static constexpr int kDim = N;
+
+  TrajectoryWriter() {}
+  TrajectoryWriter(const TrajectoryWriter&) = delete;
+  TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+  ~TrajectoryWriter() { close(); }
+
+  /**
+   * Creates (or truncates) the file at path.
+   * Tags longer than 31 characters are truncated.
+   */
+  bool create(const std::string& path, bool withDerivatives,
+      const std::string& method = "", const std::string& problem = "") {
+    close();
+    if (chunk_ == nullptr) {
+      chunk_.reset(static_cast<double*>(
+          std::aligned_alloc(Format::kAlignment, Format::kBytes)));
+      if (chunk_ == nullptr) {
+        std::cerr << "TrajectoryWriter: cannot allocate the chunk buffer"
+            << std::endl;
+        return false;
+      }
+    }
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+      std::cerr << "TrajectoryWriter: cannot create " << path << std::endl;
+      return false;
+    }
+    std::memset(&header_, 0, sizeof(header_));
+    std::memcpy(header_.magic, TrajectoryFileHeader::kMagic, 8);
+    header_.version = TrajectoryFileHeader::kVersion;
+    header_.dim = N;
+    header_.layout = static_cast<uint32_t>(Layout);
+    header_.chunkRows = ChunkRows;
+    header_.flags = withDerivatives? TrajectoryFileHeader::kDerivatives : 0;
+    method.copy(header_.method, TrajectoryFileHeader::kTagSize - 1);
+    problem.copy(header_.problem, TrajectoryFileHeader::kTagSize - 1);
+    chunkBytes_ = (withDerivatives? Format::kBytes :
+        Format::kDvOffset*sizeof(double));
+    rows_ = 0;
+    return writeHeader();
+  }
+
+  inline bool isOpen() const { return fd_ >= 0; }
+  inline size_t size() const { return header_.size + rows_; }
+
+  inline bool addPoint(double t, const Vectord<N>& x) {
+    if (header_.flags & TrajectoryFileHeader::kDerivatives) {
+      header_.flags |= TrajectoryFileHeader::kMissingDerivatives;
+    }
+    return addPoint(t, x, Vectord<N>::Zero());
+  }
+
+  inline bool addPoint(double t, const Vectord<N>& x, const Vectord<N>& dv) {
+    if (fd_ < 0) {
+      std::cerr << "TrajectoryWriter: the file is not open" << std::endl;
+      return false;
+    }
+    *Format::time(chunk_.get(), rows_) = t;
+    Format::row(chunk_.get(), Format::kXOffset, rows_) = x;
+    if (header_.flags & TrajectoryFileHeader::kDerivatives) {
+      Format::row(chunk_.get(), Format::kDvOffset, rows_) = dv;
+    }
+    if (++rows_ == ChunkRows) {
+      return flush();
+    }
+    return true;
+  }
+
+  /**
+   * Writes the last chunk, even if not full, and closes the file.
+   */
+  bool close() {
+    if (fd_ < 0) {
+      return true;
+    }
+    bool ok = rows_ == 0 || flush();
+    ok = writeHeader() && ok;
+    ::close(fd_);
+    fd_ = -1;
+    return ok;
+  }
+
+  inline void onPointAccepted(double t, const Vectord<N>& x) {
+    addPoint(t, x);
+  }
+
+  inline void onStepRejected(double t, double h) {}
+  inline void onFinished(SolverResult result) { close(); }
+
+ private:
+  struct FreeDeleter {
+    void operator()(double* chunk) const { std::free(chunk); }
+  };
+
+  bool flush() {
+    // The rows past the last point of a partial chunk still hold the
+    // previous chunk, zero them so no stale points reach the file
+    for (int i = rows_; i < ChunkRows; ++i) {
+      *Format::time(chunk_.get(), i) = 0;
+      Format::row(chunk_.get(), Format::kXOffset, i).setZero();
+      if (header_.flags & TrajectoryFileHeader::kDerivatives) {
+        Format::row(chunk_.get(), Format::kDvOffset, i).setZero();
+      }
+    }
+    const char* data = reinterpret_cast<const char*>(chunk_.get());
+    off_t offset = sizeof(header_) + header_.size/ChunkRows*chunkBytes_;
+    for (size_t done = 0; done < chunkBytes_;) {
+      ssize_t w = pwrite(fd_, data + done, chunkBytes_ - done,
+          offset + done);
+      if (w <= 0) {
+        std::cerr << "TrajectoryWriter: cannot write a chunk" << std::endl;
+        return false;
+      }
+      done += w;
+    }
+    header_.size += rows_;
+    rows_ = 0;
+    return writeHeader();
+  }
+
+  bool writeHeader() {
+    if (pwrite(fd_, &header_, sizeof(header_), 0) != sizeof(header_)) {
+      std::cerr << "TrajectoryWriter: cannot write the header" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  int fd_ = -1;
+  TrajectoryFileHeader header_{};
+  std::unique_ptr<double, FreeDeleter> chunk_;
+  size_t chunkBytes_ = 0;
+  int rows_ = 0;
+};
+
+/**
+ * TrajectoryView
+ *
+ * A read-only OdeSolution over a memory-mapped binary trajectory file.
+ * The points are read in place, without copying or parsing.
+ * The layout and chunk size of the file must match the template arguments,
+ * and the file must have derivatives if Derivatives is true.
+ * Otherwise the view has no dv column, even if the file has one.
+ */
+template <int N, SolutionLayout Layout = SolutionLayout::kSoA,
+    int ChunkRows = 4096, bool Derivatives = true>
+class TrajectoryView {
+ public:
+  using Format = SolutionChunkFormat<N, Layout, ChunkRows>;
+
+  static constexpr int kDim = N;
+  static constexpr bool kStoresDerivatives = Derivatives;
+
+  class TimeColumn {
+   public:
+    inline double operator[](size_t i) const { return *view_->time(i); }
+    inline double back() const { return (*this)[view_->size()-1]; }
+    inline size_t size() const { return view_->size(); }
+
+   private:
+    friend class TrajectoryView;
+    explicit TimeColumn(const TrajectoryView* view) : view_(view) {}
+    const TrajectoryView* view_;
+  };
+
+  class PointColumn {
+   public:
+    using ConstRow = typename Format::ConstRow;
+
+    inline ConstRow operator[](size_t i) const {
+      return view_->row(offset_, i);
+    }
+    inline ConstRow back() const { return (*this)[view_->size()-1]; }
+    inline size_t size() const { return view_->size(); }
+
+   private:
+    friend class TrajectoryView;
+    PointColumn(const TrajectoryView* view, int offset)
+      : view_(view), offset_(offset) {}
+    const TrajectoryView* view_;
+    int offset_;
+  };
+
+  // The dv column of the views without derivatives
+  struct NoColumn {
+    NoColumn(const TrajectoryView* view, int offset) {}
+  };
+
+  TrajectoryView()
+    : t(this), x(this, Format::kXOffset), dv(this, Format::kDvOffset) {}
+  TrajectoryView(const TrajectoryView&) = delete;
+  TrajectoryView& operator=(const TrajectoryView&) = delete;
+  ~TrajectoryView() { close(); }
+
+  /**
+   * Maps the file at path, which may still be being written.
+   * The view holds the points of the chunks written when it was mapped,
+   * and refresh maps the ones written since.
+   */
+  bool open(const std::string& path) {
+    close();
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0 || !map()) {
+      std::cerr << "TrajectoryView: cannot map " << path << std::endl;
+      close();
+      return false;
+    }
+    const TrajectoryFileHeader& head = header();
+    bool withDerivatives = head.flags & TrajectoryFileHeader::kDerivatives;
+    if (std::memcmp(head.magic, TrajectoryFileHeader::kMagic, 8) != 0
+        || head.version != TrajectoryFileHeader::kVersion
+        || head.dim != N
+        || head.layout != static_cast<uint32_t>(Layout)
+        || head.chunkRows != ChunkRows) {
+      std::cerr << "TrajectoryView: " << path
+          << " is not a trajectory of this dimension and layout" << std::endl;
+      close();
+      return false;
+    }
+    if (Derivatives && !withDerivatives) {
+      std::cerr << "TrajectoryView: " << path << " has no derivatives"
+          << std::endl;
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Maps the points written since the file was mapped.
+   * If it cannot, the view keeps the points it had.
+   */
+  bool refresh() {
+    if (fd_ < 0 || !map()) {
+      std::cerr << "TrajectoryView: cannot remap the file" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  void close() {
+    if (map_ != nullptr) {
+      munmap(map_, mapBytes_);
+      map_ = nullptr;
+      mapBytes_ = 0;
+      size_ = 0;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  inline bool isOpen() const { return map_ != nullptr; }
+  inline size_t size() const { return size_; }
+  inline bool empty() const { return size() == 0; }
+  inline bool containsDerivatives() const {
+    return Derivatives && map_
+        && !(header().flags & TrajectoryFileHeader::kMissingDerivatives);
+  }
+  inline std::string method() const { return map_? header().method : ""; }
+  inline std::string problem() const {
+    return map_? header().problem : "";
+  }
+
+  TimeColumn t;
+  PointColumn x;
+  [[no_unique_address]] std::conditional_t<Derivatives, PointColumn,
+      NoColumn> dv;
+
+ private:
+  inline const TrajectoryFileHeader& header() const {
+    return *static_cast<const TrajectoryFileHeader*>(map_);
+  }
+
+  inline const double* chunk(size_t i) const {
+    return reinterpret_cast<const double*>(static_cast<const char*>(map_)
+        + sizeof(TrajectoryFileHeader)) + (i/ChunkRows)*chunkDoubles_;
+  }
+
+  inline const double* time(size_t i) const {
+    return chunk(i) + i%ChunkRows;
+  }
+
+  inline typename Format::ConstRow row(int offset, size_t i) const {
+    return Format::row(chunk(i), offset, i%ChunkRows);
+  }
+
+  // Maps the whole file and takes as many points as its complete chunks
+  // hold, since the writer updates the size after writing each one.
+  // If it fails, the previous mapping is kept.
+  bool map() {
+    struct stat st;
+    if (fstat(fd_, &st) != 0
+        || static_cast<size_t>(st.st_size) < sizeof(TrajectoryFileHeader)) {
+      return false;
+    }
+    size_t bytes = st.st_size;
+    void* map = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd_, 0);
+    if (map == MAP_FAILED) {
+      return false;
+    }
+    if (map_ != nullptr) {
+      munmap(map_, mapBytes_);
+    }
+    map_ = map;
+    mapBytes_ = bytes;
+    const TrajectoryFileHeader& head = header();
+    chunkDoubles_ = (head.flags & TrajectoryFileHeader::kDerivatives)?
+        Format::kDoubles : Format::kDvOffset;
+    size_t chunks = (bytes - sizeof(TrajectoryFileHeader))
+        / (chunkDoubles_*sizeof(double));
+    size_ = std::min<size_t>(head.size, chunks*ChunkRows);
+    return true;
+  }
+
+  int fd_ = -1;
+  void* map_ = nullptr;
+  size_t mapBytes_ = 0;
+  size_t chunkDoubles_ = 0;
+  // The number of points when the file was mapped
+  size_t size_ = 0;
+};
+
+/**
+ * Writes a whole solution to a binary trajectory file.
+ * The derivatives are written if the solution contains them.
+ */
+template <SolutionLayout Layout = SolutionLayout::kSoA, OdeSolution Sol>
+bool WriteTrajectory(const std::string& path, const Sol& sol,
+    const std::string& method = "", const std::string& problem = "") {
+  TrajectoryWriter<Sol::kDim, Layout> writer;
+  bool withDerivatives = Sol::kStoresDerivatives && sol.containsDerivatives();
+  if (!writer.create(path, withDerivatives, method, problem)) {
+    return false;
+  }
+  for (size_t i = 0; i < sol.size(); ++i) {
+    bool ok;
+    if constexpr (Sol::kStoresDerivatives) {
+      ok = withDerivatives? writer.addPoint(sol.t[i], sol.x[i], sol.dv[i]) :
+          writer.addPoint(sol.t[i], sol.x[i]);
+    } else {
+      ok = writer.addPoint(sol.t[i], sol.x[i]);
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+  return writer.close();
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_TOOLS_TRAJECTORY_FILE_HPP_
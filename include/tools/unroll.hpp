@@ -0,0 +1,22 @@
+#ifndef INCLUDE_TOOLS_UNROLL_HPP_
+#define INCLUDE_TOOLS_UNROLL_HPP_
+
+#include <type_traits>
+#include <utility>
+
+namespace odelib {
+
+/**
+ * Calls f(std::integral_constant<int, I>()) for I = 0, ..., K-1,
+ * unrolled at compile time, so that f can use I as a constant.
+ */
+template <int K, typename F>
+inline void Unroll(F&& f) {
+  [&]<int... I>(std::integer_sequence<int, I...>) {
+    (f(std::integral_constant<int, I>()), ...);
+  }(std::make_integer_sequence<int, K>());
+}
+
+}  // namespace odelib
+
+#endif  // INCLUDE_TOOLS_UNROLL_HPP_
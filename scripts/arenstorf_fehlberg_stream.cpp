@@ -0,0 +1,37 @@
+#include <iostream>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the method you will use in the problem
+#include "methods/fehlberg.hpp"
+#include "solvers/plain_adaptive_method_solver.hpp"
+// Include a sink for the points
+#include "sinks/basic_sinks.hpp"
+using namespace std;
+using namespace odelib;
+
+SizeArgs args;
+
+// Integrates without storing the trajectory
+// and prints only the final state and the number of steps.
+int main(int argc, char** argv) {
+  if (argc != 5) {
+    cerr << "Usage: <program> <max_time> <min_step_allowed> <max_step_allowed> "
+        << "<tolerance>" << endl;
+    return -1;
+  }
+  args.maxTime = atof(argv[1]);
+  args.minStepAllowed = atof(argv[2]);
+  args.maxStepAllowed = atof(argv[3]);
+  args.tolerance = atof(argv[4]);
+  Arenstorf ivp;
+  LastPointSink<4> last;
+  auto result = StreamPastMaxTime(ivp.t0(), ivp.x0(), Fehlberg(),
+      Arenstorf::Dv(), args, last);
+  cout << last.t << '\t' << last.x[0] << '\t' << last.x[1] << '\n';
+  cerr << last.accepted << " accepted and " << last.rejected
+      << " rejected steps" << endl;
+  if (result != SolverResult::kOk) {
+    LogResult(result);
+    return -2;
+  }
+}
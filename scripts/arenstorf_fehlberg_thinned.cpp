@@ -0,0 +1,38 @@
+#include <iostream>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the method you will use in the problem
+#include "methods/fehlberg.hpp"
+#include "solvers/thinning_solver.hpp"
+// Include a container for the solution
+#include "solutions/standard_ode_solution.hpp"
+// Include additional tools
+#include "tools/tsv_output.hpp"
+using namespace std;
+using namespace odelib;
+
+SizeArgs args;
+
+// Stores only the points that cannot be rebuilt by interpolation
+// within the given error, and prints them.
+int main(int argc, char** argv) {
+  if (argc != 6) {
+    cerr << "Usage: <program> <max_time> <min_step_allowed> <max_step_allowed> "
+        << "<tolerance> <max_reconstruction_error>" << endl;
+    return -1;
+  }
+  args.maxTime = atof(argv[1]);
+  args.minStepAllowed = atof(argv[2]);
+  args.maxStepAllowed = atof(argv[3]);
+  args.tolerance = atof(argv[4]);
+  StandardOdeSolution sol = StandardOdeSolutionFromIvp(Arenstorf());
+  auto [result, error] = ThinningExtendPastMaxTime(sol, Fehlberg(),
+      Arenstorf::Dv(), args, atof(argv[5]));
+  PrintSolutionWithTime(cout, sol, {0, 1});
+  cerr << sol.size() << " points stored, reconstruction error " << error
+      << endl;
+  if (result != SolverResult::kOk) {
+    LogResult(result);
+    return -2;
+  }
+}
@@ -5,7 +5,7 @@
 #include "methods/rk4.hpp"
 #include "solvers/plain_method_solver.hpp"
 // Include a container for the solution
-#include "solutions/standard_ode_solution.hpp"
+#include "solutions/derivative_free_ode_solution.hpp"
 // Include additional tools
 #include "tools/tsv_output.hpp"
 using namespace std;
@@ -20,7 +20,8 @@ int main(int argc, char** argv) {
   }
   args.maxTime = atof(argv[1]);
   args.fixedStepSize = atof(argv[2]);
-  StandardOdeSolution sol = StandardOdeSolutionFromIvp(Arenstorf());
+  DerivativeFreeOdeSolution sol =
+      DerivativeFreeOdeSolutionFromIvp(Arenstorf());
   auto result = ExtendPastMaxTime(sol, RK4(), Arenstorf::Dv(), args);
   PrintSolution(cout, sol, {0, 1}, 3000);
   if (result != SolverResult::kOk) {
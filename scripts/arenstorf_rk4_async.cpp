@@ -0,0 +1,34 @@
+#include <iostream>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the method you will use in the problem
+#include "methods/rk4.hpp"
+#include "solvers/plain_method_solver.hpp"
+// Include the sinks that print the points while integrating
+#include "sinks/async_sink.hpp"
+#include "sinks/tsv_sink.hpp"
+using namespace std;
+using namespace odelib;
+
+SizeArgs args;
+
+// Prints the whole orbit while it is being integrated,
+// from a writer thread, without storing it.
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    cerr << "Usage: <program> <max_time> <step_size>" << endl;
+    return -1;
+  }
+  args.maxTime = atof(argv[1]);
+  args.fixedStepSize = atof(argv[2]);
+  Arenstorf ivp;
+  TsvSink<4> tsv(cout, {0, 1});
+  AsyncSink<4, TsvSink<4>&> async(tsv);
+  async.onPointAccepted(ivp.t0(), ivp.x0());
+  auto result = StreamPastMaxTime(ivp.t0(), ivp.x0(), RK4(), Arenstorf::Dv(),
+      args, async);
+  if (result != SolverResult::kOk) {
+    LogResult(result);
+    return -2;
+  }
+}
@@ -0,0 +1,100 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the method you will use in the problem
+#include "methods/rk4.hpp"
+#include "solvers/plain_method_solver.hpp"
+// Include a container for the solution
+#include "solutions/standard_ode_solution.hpp"
+// Include the outputs to compare
+#include "sinks/async_sink.hpp"
+#include "sinks/tsv_sink.hpp"
+#include "tools/fast_tsv_output.hpp"
+#include "tools/trajectory_file.hpp"
+using namespace std;
+using namespace odelib;
+
+SizeArgs args;
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// Integrates Arenstorf's problem with RK4 and writes every point
+// as TSV and as a binary trajectory file, in three ways:
+// storing the solution and writing it afterwards,
+// streaming it to the writer from the solver thread,
+// and streaming it to the writer from a writer thread.
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    cerr << "Usage: <program> <number_of_points> <output_prefix>" << endl;
+    return -1;
+  }
+  size_t n = atoll(argv[1]);
+  string tsvPath = string(argv[2]) + ".tsv";
+  string binPath = string(argv[2]) + ".odt";
+  args.fixedStepSize = 17.0652165601579625588917206249/n;
+  args.maxTime = n*args.fixedStepSize;
+  Arenstorf ivp;
+  auto f = Arenstorf::Dv();
+
+  double compute = Seconds([&]() {
+    StreamPastMaxTime(ivp.t0(), ivp.x0(), RK4(), f, args, DiscardSink());
+  });
+
+  cout << "# format\tcompute (s)\tstore then write (s)\tstream (s)"
+       << "\tasync stream (s)\n";
+  // TSV
+  {
+    double stored = Seconds([&]() {
+      StandardOdeSolution sol = StandardOdeSolutionFromIvp(ivp);
+      ExtendPastMaxTime(sol, RK4(), f, args);
+      ofstream out(tsvPath);
+      FastPrintSolutionWithTime(out, sol, {0, 1, 2, 3}, sol.size(), 1);
+    });
+    double stream = Seconds([&]() {
+      ofstream out(tsvPath);
+      TsvSink<4> tsv(out);
+      StreamPastMaxTime(ivp.t0(), ivp.x0(), RK4(), f, args, tsv);
+    });
+    double async = Seconds([&]() {
+      ofstream out(tsvPath);
+      TsvSink<4> tsv(out);
+      StreamPastMaxTime(ivp.t0(), ivp.x0(), RK4(), f, args,
+          AsyncSink<4, TsvSink<4>&>(tsv));
+    });
+    cout << "tsv\t" << compute << '\t' << stored << '\t' << stream << '\t'
+         << async << '\n';
+  }
+  // Binary
+  {
+    double stored = Seconds([&]() {
+      StandardOdeSolution sol = StandardOdeSolutionFromIvp(ivp);
+      ExtendPastMaxTime(sol, RK4(), f, args);
+      WriteTrajectory(binPath, sol, "RK4", "Arenstorf");
+    });
+    double stream = Seconds([&]() {
+      TrajectoryWriter<4> writer;
+      writer.create(binPath, false, "RK4", "Arenstorf");
+      StreamPastMaxTime(ivp.t0(), ivp.x0(), RK4(), f, args, writer);
+    });
+    double async = Seconds([&]() {
+      TrajectoryWriter<4> writer;
+      writer.create(binPath, false, "RK4", "Arenstorf");
+      StreamPastMaxTime(ivp.t0(), ivp.x0(), RK4(), f, args,
+          AsyncSink<4, TrajectoryWriter<4>&>(writer));
+    });
+    cout << "binary\t" << compute << '\t' << stored << '\t' << stream << '\t'
+         << async << '\n';
+  }
+  remove(tsvPath.c_str());
+  remove(binPath.c_str());
+}
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "tools/interpolation.hpp"
+using namespace std;
+using namespace odelib;
+using namespace odelib::interpolation;
+
+constexpr int N = 4;
+constexpr int K = 4;
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// The divided differences with the number of nodes known at run time,
+// as Hermite computed them before the unrolled kernels.
+// The table of sz*sz differences, indexed i*sz + j, is given by the caller
+// so that its allocation is not measured.
+Vectord<N> RuntimeNewton(const double* x, const Vectord<N>* y, int sz,
+    double x0, vector<Vectord<N>>& diff_table) {
+  std::copy(y, y + sz, diff_table.begin());
+  for (int i = 1; i < sz; ++i) {
+    for (int j = i; j < sz; ++j) {
+      diff_table[i*sz + j] = (diff_table[(i-1)*sz + j]
+          - diff_table[(i-1)*sz + j-1]) / (x[j] - x[j-i]);
+    }
+  }
+  Vectord<N> y0 = diff_table[(sz-1)*sz + sz-1];
+  for (int i = sz-2; i >= 0; --i) {
+    y0 = diff_table[i*sz + i] + (x0 - x[i])*y0;
+  }
+  return y0;
+}
+
+// Measures the time per call of every kernel, interpolating inside
+// K nodes taken from a pool of random data sets,
+// so that no work can be hoisted out of the loop.
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    cerr << "Usage: <program> <number_of_calls>" << endl;
+    return -1;
+  }
+  size_t calls = atoll(argv[1]);
+  // The number of nodes is read through a volatile so that
+  // RuntimeNewton and Hermite only know it at run time
+  volatile int runtimeNodes = K;
+  int sz = runtimeNodes;
+  vector<Vectord<N>> diff_table(sz*sz);
+  constexpr size_t kSets = 64;
+  mt19937_64 gen(1);
+  uniform_real_distribution<double> dist(-1, 1);
+  auto random = [&]() {
+    return Vectord<N>(Vectord<N>::NullaryExpr([&]() { return dist(gen); }));
+  };
+  vector<array<double, K>> x(kSets), w(kSets);
+  vector<array<Vectord<N>, K>> y(kSets), dy(kSets), ddy(kSets);
+  for (size_t s = 0; s < kSets; ++s) {
+    for (int i = 0; i < K; ++i) {
+      x[s][i] = i + dist(gen)/4;
+      y[s][i] = random();
+      dy[s][i] = random();
+      ddy[s][i] = random();
+    }
+    w[s] = BarycentricWeights<K>(x[s]);
+  }
+  vector<double> times(1024);
+  for (double& t : times) {
+    t = 1 + (dist(gen) + 1)/2;
+  }
+
+  // Every kernel accumulates its results so that none is optimized away
+  Vectord<N> sum = Vectord<N>::Zero();
+  auto measure = [&](const char* name, auto kernel) {
+    double s = Seconds([&]() {
+      for (size_t i = 0; i < calls; ++i) {
+        sum += kernel(i % kSets, times[i & 1023]);
+      }
+    });
+    cout << name << '\t' << 1e9*s/calls << '\n';
+  };
+
+  cout << "# kernel\ttime per call (ns)\n";
+  measure("runtime Newton", [&](size_t s, double t) {
+    return RuntimeNewton(x[s].data(), y[s].data(), sz, t, diff_table);
+  });
+  measure("Hermite dispatch", [&](size_t s, double t) {
+    return Hermite(x[s].data(), y[s].data(), sz, t);
+  });
+  measure("Newton<4>", [&](size_t s, double t) {
+    return Newton<K, N>(x[s], y[s], t);
+  });
+  measure("Barycentric<4>", [&](size_t s, double t) {
+    return Barycentric<K, N>(x[s], y[s], t);
+  });
+  measure("Barycentric<4> with weights", [&](size_t s, double t) {
+    return Barycentric<K, N>(x[s], w[s], y[s], t);
+  });
+  measure("CubicHermite", [&](size_t s, double t) {
+    return CubicHermite<N>(x[s][1], y[s][1], dy[s][1], x[s][2], y[s][2],
+        dy[s][2], t);
+  });
+  measure("QuinticHermite", [&](size_t s, double t) {
+    return QuinticHermite<N>(x[s][1], y[s][1], dy[s][1], ddy[s][1], x[s][2],
+        y[s][2], dy[s][2], ddy[s][2], t);
+  });
+  cerr << sum.sum() << endl;
+}
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+// Include the methods to compare
+#include "methods/carpenter_kennedy_4.hpp"
+#include "methods/rk4.hpp"
+#include "methods/ssprk104.hpp"
+#include "methods/ssprk3.hpp"
+#include "methods/williamson_3.hpp"
+#include "solvers/plain_method_solver.hpp"
+using namespace std;
+using namespace odelib;
+
+// Linear advection, u_t + u_x = 0, on the periodic interval [0, 1),
+// discretized with n points and first order upwind differences
+struct Advection {
+  static constexpr int kDim = Eigen::Dynamic;
+
+  inline Vectord<kDim> operator()(double t, const Vectord<kDim>& x) const {
+    size_t n = x.size();
+    Vectord<kDim> d(n);
+    d[0] = (x[n-1] - x[0])*n;
+    d.tail(n-1) = (x.head(n-1) - x.tail(n-1))*n;
+    return d;
+  }
+};
+
+// Keeps the point at the end of the integration only,
+// so that the sink does not add memory traffic to the steps
+struct FinalPointSink {
+  static constexpr int kDim = Eigen::Dynamic;
+
+  inline void onPointAccepted(double t, const Vectord<kDim>& x) {
+    if (t >= tEnd) {
+      this->t = t;
+      this->x = x;
+    }
+  }
+
+  inline void onStepRejected(double t, double h) {}
+
+  inline void onFinished(SolverResult result) {}
+
+  double tEnd;
+  double t = 0;
+  Vectord<kDim> x;
+};
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+Vectord<Eigen::Dynamic> x0;
+SizeArgs args;
+
+// The exact solution, the initial wave moved t to the right
+Vectord<Eigen::Dynamic> Exact(size_t n, double t) {
+  Vectord<Eigen::Dynamic> x(n);
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = std::sin(2*M_PI*(double(i)/n - t));
+  }
+  return x;
+}
+
+// Integrates with a method and compares the final state
+// with the exact solution, in the root mean square norm
+template <typename Met>
+void Measure(const char* name, const Met& met, size_t vectors) {
+  FinalPointSink last{args.maxTime - args.fixedStepSize/2};
+  double seconds = Seconds([&]() {
+    StreamPastMaxTime(0, x0, met, Advection(), args, last);
+  });
+  double error = (last.x - Exact(x0.size(), last.t)).norm()
+      / std::sqrt(x0.size());
+  cout << name << '\t' << vectors << '\t' << seconds << '\t' << error
+       << '\n';
+}
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    cerr << "Usage: <program> <number_of_unknowns> <number_of_steps>"
+        << endl;
+    return -1;
+  }
+  size_t n = atoll(argv[1]);
+  size_t steps = atoll(argv[2]);
+  x0 = Exact(n, 0);
+  // Courant number 1/2, stable for all the methods
+  args.fixedStepSize = 0.5/n;
+  args.maxTime = steps*args.fixedStepSize;
+
+  // The vectors of size n alive during a step, besides the derivative
+  // returned by the problem: the point, the hint and the stages of the
+  // Runge-Kutta engine, or the point and the work vector of the
+  // in place methods
+  cout << "# method\tvectors\tseconds\terror\n";
+  Measure("SSPRK3", SSPRK3(), 6);
+  Measure("Williamson3", Williamson3(), 2);
+  Measure("RK4", RK4(), 7);
+  Measure("CarpenterKennedy4", CarpenterKennedy4(), 2);
+  Measure("SSPRK104", SSPRK104(), 2);
+}
@@ -0,0 +1,78 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the method you will use in the problem
+#include "methods/rk4.hpp"
+#include "solvers/plain_method_solver.hpp"
+// Include the containers for the solution
+#include "solutions/derivative_free_ode_solution.hpp"
+#include "solutions/standard_ode_solution.hpp"
+// Include the batched interpolation
+#include "tools/batch_interpolation.hpp"
+using namespace std;
+using namespace odelib;
+
+SizeArgs args;
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// Resamples the solution onto a uniform grid calling Interpolate
+// for every time and with InterpolateMany, with one and all threads,
+// and reports the time per point. The derivatives are used when stored.
+template <OdeSolution Sol>
+void Resample(const char* name, const Sol& sol, size_t m) {
+  vector<double> times(m);
+  double t0 = sol.t[0], t1 = sol.t[sol.size()-1];
+  for (size_t i = 0; i < m; ++i) {
+    times[i] = t0 + (t1 - t0)*i/(m-1);
+  }
+  vector<Vectord<4>> out(m);
+  double loop = Seconds([&]() {
+    for (size_t i = 0; i < m; ++i) {
+      if (auto x = Interpolate(sol, times[i], 3, true)) {
+        out[i] = *x;
+      }
+    }
+  });
+  double sweep = Seconds([&]() {
+    InterpolateMany(sol, span<const double>(times), span<Vectord<4>>(out), 1,
+        true);
+  });
+  unsigned threads = thread::hardware_concurrency();
+  double parallel = Seconds([&]() {
+    InterpolateMany(sol, span<const double>(times), span<Vectord<4>>(out),
+        threads, true);
+  });
+  cout << name << '\t' << 1e9*loop/m << '\t' << 1e9*sweep/m << '\t'
+       << 1e9*parallel/m << '\n';
+}
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    cerr << "Usage: <program> <number_of_points> <number_of_times>" << endl;
+    return -1;
+  }
+  size_t n = atoll(argv[1]);
+  size_t m = atoll(argv[2]);
+  args.fixedStepSize = 17.0652165601579625588917206249/n;
+  args.maxTime = n*args.fixedStepSize;
+  StandardOdeSolution sol = StandardOdeSolutionFromIvp(Arenstorf());
+  ExtendPastMaxTime(sol, RK4(), Arenstorf::Dv(), args);
+  DerivativeFreeOdeSolution freeSol =
+      DerivativeFreeOdeSolutionFromIvp(Arenstorf());
+  ExtendPastMaxTime(freeSol, RK4(), Arenstorf::Dv(), args);
+
+  cout << "# solution\tInterpolate (ns/time)\tInterpolateMany (ns/time)"
+       << "\tparallel InterpolateMany (ns/time)\n";
+  Resample("derivatives", sol, m);
+  Resample("derivative free", freeSol, m);
+}
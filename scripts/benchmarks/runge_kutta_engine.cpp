@@ -0,0 +1,172 @@
+#include <chrono>
+#include <iostream>
+#include <utility>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the methods to compare
+#include "methods/euler.hpp"
+#include "methods/fehlberg.hpp"
+#include "methods/mod_euler.hpp"
+#include "methods/rk4.hpp"
+#include "methods/ssprk3.hpp"
+#include "solvers/plain_adaptive_method_solver.hpp"
+#include "solvers/plain_method_solver.hpp"
+// Include a sink for the points
+#include "sinks/basic_sinks.hpp"
+using namespace std;
+using namespace odelib;
+
+// The methods as they were written before the Butcher tableau engine
+namespace handcoded {
+
+struct Euler {
+  static constexpr int kOrder = 1;
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
+      double h) const {
+    return hinted_step(f, t, x, h, f(t, x));
+  }
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
+      double h, const Vectord<D::kDim>& dv) const {
+    return x + dv*h;
+  }
+};
+
+struct ModEuler {
+  static constexpr int kOrder = 2;
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
+      double h) const {
+    return hinted_step(f, t, x, h, f(t, x));
+  }
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
+      double h, const Vectord<D::kDim>& dv) const {
+    return x + (dv*h + f(t+h, x+dv*h)*h)/2;
+  }
+};
+
+struct SSPRK3 {
+  static constexpr int kOrder = 3;
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
+      double h) const {
+    return hinted_step(f, t, x, h, f(t, x));
+  }
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
+      double h, const Vectord<D::kDim>& dv) const {
+    Vectord<D::kDim> k[3];
+    k[0] = h*dv;
+    k[1] = h*f(t + h, x + k[0]);
+    k[2] = h*f(t + h/2, x + k[0]/4 + k[1]/4);
+    return x + (k[0] + k[1] + k[2]*4)/6;
+  }
+};
+
+struct RK4 {
+  static constexpr int kOrder = 4;
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> step(D f, double t, const Vectord<D::kDim>& x,
+      double h) const {
+    return hinted_step(f, t, x, h, f(t, x));
+  }
+
+  template <IvpDerivative D>
+  inline Vectord<D::kDim> hinted_step(D f, double t, const Vectord<D::kDim>& x,
+      double h, const Vectord<D::kDim>& d) const {
+    Vectord<D::kDim> k[4];
+    k[0] = d*h;
+    k[1] = f(t+h/2, x + k[0]/2)*h;
+    k[2] = f(t+h/2, x + k[1]/2)*h;
+    k[3] = f(t+h, x + k[2])*h;
+    return x + (k[0] + 2*k[1] + 2*k[2] + k[3])/6;
+  }
+};
+
+struct Fehlberg {
+  static constexpr int kOrder = 4;
+
+  template <IvpDerivative D>
+  inline std::pair<Vectord<D::kDim>, double> step(D f, double t,
+      const Vectord<D::kDim>& x, double& h, double tolerance) const {
+    Vectord<D::kDim> k[6];
+    k[0] = h*f(t, x);
+    k[1] = h*f(t +   1/4.0*h, x + 1/4.0*k[0]);
+    k[2] = h*f(t +   3/8.0*h, x + (3*k[0] + 9*k[1])/32);
+    k[3] = h*f(t + 12/13.0*h, x + (1932*k[0] - 7200*k[1] + 7296*k[2])/2197);
+    k[4] = h*f(t +         h, x + 439/216.0*k[0] - 8*k[1] + 3680/513.0*k[2]
+                                - 845/4104.0*k[3]);
+    k[5] = h*f(t +   1/2.0*h, x - 8/27.0*k[0] + 2*k[1] - 3544/2565.0*k[2]
+                                + 1859/4104.0*k[3] - 11/40.0*k[4]);
+    Vectord<D::kDim> rk4 = x + 25/216.0*k[0] + 1408/2565.0*k[2]
+                          + 2197/4104.0*k[3] - 1/5.0*k[4];
+    Vectord<D::kDim> rk5 = x + 16/135.0*k[0] + 6656/12825.0*k[2]
+                        + 28561/56430.0*k[3] - 9/50.0*k[4] + 2/55.0*k[5];
+    double error = (rk5 - rk4).norm();
+    double q = std::pow(tolerance * h / (2*error), 0.25);
+    q = std::max(0.1, std::min(q, 4.0));
+    h *= q;
+    return {rk5, error};
+  }
+};
+
+}  // namespace handcoded
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+Arenstorf ivp;
+SizeArgs args;
+
+// Integrates with both versions of a method and reports their times
+// and the difference between their final states.
+template <typename Old, typename New>
+void Compare(const char* name, const Old& oldMet, const New& newMet) {
+  LastPointSink<4> oldLast, newLast;
+  double oldTime = Seconds([&]() {
+    StreamPastMaxTime(ivp.t0(), ivp.x0(), oldMet, Arenstorf::Dv(), args,
+        oldLast);
+  });
+  double newTime = Seconds([&]() {
+    StreamPastMaxTime(ivp.t0(), ivp.x0(), newMet, Arenstorf::Dv(), args,
+        newLast);
+  });
+  cout << name << '\t' << oldTime << '\t' << newTime << '\t'
+       << oldLast.accepted << '\t' << newLast.accepted << '\t'
+       << (oldLast.x - newLast.x).norm() << '\n';
+}
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    cerr << "Usage: <program> <number_of_steps> <tolerance>" << endl;
+    return -1;
+  }
+  size_t n = atoll(argv[1]);
+  args.maxTime = 17.0652165601579625588917206249;
+  args.fixedStepSize = args.maxTime/n;
+  args.tolerance = atof(argv[2]);
+  args.minStepAllowed = 1e-12;
+  args.maxStepAllowed = 1e-1;
+
+  cout << "# method\thandcoded (s)\tengine (s)\thandcoded steps"
+       << "\tengine steps\tdifference\n";
+  Compare("Euler", handcoded::Euler(), Euler());
+  Compare("ModEuler", handcoded::ModEuler(), ModEuler());
+  Compare("SSPRK3", handcoded::SSPRK3(), SSPRK3());
+  Compare("RK4", handcoded::RK4(), RK4());
+  Compare("Fehlberg", handcoded::Fehlberg(), Fehlberg());
+}
@@ -0,0 +1,73 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the method you will use in the problem
+#include "methods/rk4.hpp"
+#include "solvers/plain_method_solver.hpp"
+// Include the containers for the solutions
+#include "solutions/derivative_free_ode_solution.hpp"
+#include "solutions/standard_ode_solution.hpp"
+// Include the comparison
+#include "tools/solution_comparison.hpp"
+using namespace std;
+using namespace odelib;
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// Compares two RK4 solutions of Arenstorf's problem with different steps
+// interpolating one point at a time with Interpolate,
+// and with CompareSolutions with one and all threads.
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    cerr << "Usage: <program> <number_of_points>" << endl;
+    return -1;
+  }
+  size_t n = atoll(argv[1]);
+  SizeArgs args;
+  args.maxTime = 17.0652165601579625588917206249;
+  args.fixedStepSize = args.maxTime/n;
+  StandardOdeSolution lhs = StandardOdeSolutionFromIvp(Arenstorf());
+  ExtendPastMaxTime(lhs, RK4(), Arenstorf::Dv(), args);
+  args.fixedStepSize = args.maxTime/(n/3*2);
+  DerivativeFreeOdeSolution rhs =
+      DerivativeFreeOdeSolutionFromIvp(Arenstorf());
+  ExtendPastMaxTime(rhs, RK4(), Arenstorf::Dv(), args);
+
+  double maxErr = 0;
+  double loop = Seconds([&]() {
+    auto compare = [&](const auto& a, const auto& b) {
+      for (size_t i = 0; i < a.size(); ++i) {
+        if (auto x = Interpolate(b, a.t[i], 3, true)) {
+          maxErr = max(maxErr, (a.x[i] - *x).norm());
+        }
+      }
+    };
+    compare(lhs, rhs);
+    compare(rhs, lhs);
+  });
+  SolutionDifference<4> diff;
+  double single = Seconds([&]() { diff = CompareSolutions(lhs, rhs); });
+  unsigned threads = thread::hardware_concurrency();
+  double parallel = Seconds([&]() {
+    diff = CompareSolutions(lhs, rhs, threads);
+  });
+
+  cout << "# Interpolate (s)\tCompareSolutions (s)\t"
+       << "parallel CompareSolutions (s)\n";
+  cout << loop << '\t' << single << '\t' << parallel << '\n';
+  cout << "# max\tmean\trms\tmax per component\n";
+  cout << diff.max << '\t' << diff.mean << '\t' << diff.rms << '\t'
+       << diff.maxComponent.transpose() << '\n';
+  if (maxErr != diff.max) {
+    cerr << "The maximum differences do not match" << endl;
+    return -2;
+  }
+}
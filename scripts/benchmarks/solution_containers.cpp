@@ -0,0 +1,74 @@
+#include <chrono>
+#include <iostream>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the method you will use in the problem
+#include "methods/rk4.hpp"
+#include "solvers/plain_method_solver.hpp"
+// Include the containers to compare
+#include "solutions/standard_ode_solution.hpp"
+#include "solutions/chunked_ode_solution.hpp"
+#include "solutions/derivative_free_ode_solution.hpp"
+using namespace std;
+using namespace odelib;
+
+SizeArgs args;
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// Measures the container alone, adding points one by one
+// the way the adaptive solvers do.
+template <OdeSolution Sol>
+double FillTime(size_t n) {
+  Sol sol;
+  Vectord<Sol::kDim> x = Arenstorf::x0();
+  double elapsed = Seconds([&]() {
+    for (size_t i = 0; i < n; ++i) {
+      sol.addPoint(i, x, x);
+      x[0] += 1e-9;
+    }
+  });
+  // Use the solution so that the loop is not optimized away
+  if (sol.x[n-1][0] < 0) cerr << "";
+  return elapsed;
+}
+
+template <OdeSolution Sol>
+double SolveTime(Sol sol) {
+  double elapsed = Seconds([&]() {
+    ExtendPastMaxTime(sol, RK4(), Arenstorf::Dv(), args);
+  });
+  if (sol.x[sol.size()-1][0] < -1e9) cerr << "";
+  return elapsed;
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    cerr << "Usage: <program> <number_of_points>" << endl;
+    return -1;
+  }
+  size_t n = atoll(argv[1]);
+  args.fixedStepSize = 1e-6;
+  args.maxTime = n*args.fixedStepSize;
+
+  cout << "# container\tfill (s)\trk4 arenstorf (s)\n";
+  cout << "standard\t" << FillTime<StandardOdeSolution<4>>(n) << '\t'
+       << SolveTime(StandardOdeSolutionFromIvp(Arenstorf())) << '\n';
+  cout << "chunked_soa\t"
+       << FillTime<ChunkedOdeSolution<4, SolutionLayout::kSoA>>(n) << '\t'
+       << SolveTime(ChunkedOdeSolutionFromIvp<SolutionLayout::kSoA>(
+              Arenstorf())) << '\n';
+  cout << "chunked_aosoa\t"
+       << FillTime<ChunkedOdeSolution<4, SolutionLayout::kAoSoA>>(n) << '\t'
+       << SolveTime(ChunkedOdeSolutionFromIvp<SolutionLayout::kAoSoA>(
+              Arenstorf())) << '\n';
+  cout << "derivative_free\t"
+       << FillTime<DerivativeFreeOdeSolution<4>>(n) << '\t'
+       << SolveTime(DerivativeFreeOdeSolutionFromIvp(Arenstorf())) << '\n';
+}
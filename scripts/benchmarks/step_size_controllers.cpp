@@ -0,0 +1,100 @@
+#include <iostream>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the methods to compare
+#include "methods/dormand_prince_54.hpp"
+#include "methods/dormand_prince_853.hpp"
+#include "methods/fehlberg.hpp"
+#include "methods/richardson_extrapolation.hpp"
+#include "methods/rk4.hpp"
+#include "methods/verner_65.hpp"
+#include "solvers/plain_adaptive_method_solver.hpp"
+#include "solvers/step_size_controllers.hpp"
+// Include a sink for the points
+#include "sinks/basic_sinks.hpp"
+using namespace std;
+using namespace odelib;
+
+// The derivative of Arenstorf's problem, counting its evaluations
+struct CountingDv {
+  static constexpr int kDim = 4;
+
+  inline Vectord<4> operator()(double t, const Vectord<4>& x) const {
+    ++*evaluations;
+    return Arenstorf::Dv()(t, x);
+  }
+
+  size_t* evaluations;
+};
+
+Arenstorf ivp;
+SizeArgs args;
+Vectord<4> reference;
+
+// Integrates a period with a method and a controller,
+// returning the point at the period. The last point is past it,
+// so it is moved back with a single step of DormandPrince853.
+template <typename Met, typename Ctrl>
+Vectord<4> Integrate(const Met& met, const Ctrl& ctrl, size_t& evaluations,
+    LastPointSink<4>& last) {
+  StreamPastMaxTime(ivp.t0(), ivp.x0(), met, CountingDv{&evaluations}, args,
+      last, ctrl);
+  if (last.result != SolverResult::kOk) {
+    LogResult(last.result);
+  }
+  double h = args.maxTime - last.t;
+  return DormandPrince853().step(Arenstorf::Dv(), last.t, last.x, h,
+      args.tolerance).first;
+}
+
+template <typename Met, typename Ctrl>
+void Measure(const char* method, const char* controller, const Met& met,
+    const Ctrl& ctrl) {
+  size_t evaluations = 0;
+  LastPointSink<4> last;
+  Vectord<4> x = Integrate(met, ctrl, evaluations, last);
+  cout << args.tolerance << '\t' << method << '\t' << controller << '\t'
+       << last.accepted << '\t' << last.rejected << '\t' << evaluations
+       << '\t' << (x - reference).norm() << '\n';
+}
+
+template <typename Met>
+void Compare(const char* method, const Met& met) {
+  Measure(method, "Elementary", met, ElementaryController());
+  Measure(method, "GustafssonPI", met, GustafssonPIController());
+  Measure(method, "PredictivePI", met, PredictivePIController());
+  Measure(method, "H211PI", met, H211PIController());
+  Measure(method, "H211b", met, H211bController());
+  Measure(method, "H312PID", met, H312PIDController());
+}
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    cerr << "Usage: <program> <highest_tolerance> <lowest_tolerance>" << endl;
+    return -1;
+  }
+  double highest = atof(argv[1]);
+  double lowest = atof(argv[2]);
+  args.maxTime = 17.0652165601579625588917206249;
+  args.minStepAllowed = 1e-12;
+  args.maxStepAllowed = 1e-1;
+
+  // The initial point is only given with ten digits, so the orbit
+  // is not closed and the error is measured against a solution
+  // of DormandPrince853 at a much lower tolerance
+  size_t evaluations = 0;
+  LastPointSink<4> last;
+  args.tolerance = 3e-11;
+  reference = Integrate(DormandPrince853(), PredictivePIController(),
+      evaluations, last);
+
+  cout << "# tolerance\tmethod\tcontroller\taccepted\trejected"
+       << "\tevaluations\terror\n";
+  for (double tol = highest; tol >= lowest*0.99; tol /= 10) {
+    args.tolerance = tol;
+    Compare("Fehlberg", Fehlberg());
+    Compare("Richardson<RK4>", RichardsonExtrapolation<RK4>());
+    Compare("DormandPrince54", DormandPrince54());
+    Compare("Verner65", Verner65());
+  }
+}
@@ -0,0 +1,209 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+// Select the problems you want to solve
+#include "problems/brusselator.hpp"
+#include "problems/rigid1.hpp"
+#include "problems/robertson.hpp"
+// Include the methods to compare
+#include "methods/backward_differentiation_formulas.hpp"
+#include "methods/bdf_nordsieck.hpp"
+#include "methods/dormand_prince_54.hpp"
+#include "methods/dormand_prince_853.hpp"
+#include "methods/esdirk_32.hpp"
+#include "methods/esdirk_43.hpp"
+#include "methods/radau_iia_5.hpp"
+#include "methods/rodas4.hpp"
+#include "methods/ros3p.hpp"
+#include "methods/rosenbrock_23.hpp"
+#include "methods/sdirk_4.hpp"
+#include "methods/tr_bdf2.hpp"
+#include "methods/trapezoidal.hpp"
+#include "solvers/newton_implicit_solver.hpp"
+#include "solvers/nordsieck_method_solver.hpp"
+#include "solvers/plain_adaptive_method_solver.hpp"
+// Include a container for the reference solution and a sink for the points
+#include "solutions/standard_ode_solution.hpp"
+#include "sinks/basic_sinks.hpp"
+using namespace std;
+using namespace odelib;
+
+// A derivative that counts its evaluations and the ones of its Jacobian.
+// The counters are shared, since the implicit equations of the fixed step
+// BDFs construct their own derivative.
+template <IvpDerivative Dv>
+struct CountingDv {
+  static constexpr int kDim = Dv::kDim;
+
+  inline Vectord<kDim> operator()(double t, const Vectord<kDim>& x) const {
+    ++evaluations;
+    return Dv()(t, x);
+  }
+
+  inline Matrixd<kDim, kDim> pdvx(double t, const Vectord<kDim>& x) const {
+    ++jacobians;
+    return Dv().pdvx(t, x);
+  }
+
+  inline Vectord<kDim> pdvt(double t, const Vectord<kDim>& x) const
+      requires TimeDerivableIvpDerivative<Dv> {
+    return Dv().pdvt(t, x);
+  }
+
+  static inline size_t evaluations = 0;
+  static inline size_t jacobians = 0;
+};
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+SizeArgs args;
+
+// Solves a stiff problem with the methods and compares their last point
+// with a reference solution, interpolated at its time
+// with the dense output of DormandPrince853.
+template <InitialValueProblem Ivp>
+class StiffWorkPrecision {
+ public:
+  using Dv = typename Ivp::Dv;
+  using Counting = CountingDv<Dv>;
+  static constexpr int N = Dv::kDim;
+
+  // The reference goes past the maximum time
+  // to contain the last step of every method
+  StiffWorkPrecision(Ivp ivp, double referenceTolerance)
+    : ivp_(ivp), reference_(StandardOdeSolutionFromIvp(ivp)) {
+    SizeArgs refArgs = args;
+    refArgs.tolerance = referenceTolerance;
+    refArgs.maxTime *= 1.5;
+    LogResult(ExtendPastMaxTime(reference_, DormandPrince853(), Dv(),
+        refArgs));
+  }
+
+  template <typename Met>
+  void measure(const char* name, const Met& met) {
+    Counting::evaluations = Counting::jacobians = 0;
+    LastPointSink<N> last;
+    double seconds = Seconds([&]() {
+      StreamPastMaxTime(ivp_.t0(), ivp_.x0(), met, Counting(), args, last);
+    });
+    LogResult(last.result);
+    print(args.tolerance, name, last.accepted, last.rejected, seconds,
+        last.t, last.x);
+  }
+
+  // The fixed step BDFs, started with the trapezoidal rule
+  // like SolvePastMaxTime, with a step of args.fixedStepSize
+  // and args.tolerance for the Newton iteration
+  template <int Order>
+  void measureFixed() {
+    Counting::evaluations = Counting::jacobians = 0;
+    StandardOdeSolution sol = StandardOdeSolutionFromIvp(ivp_);
+    SolverResult result;
+    double seconds = Seconds([&]() {
+      result = NewtonAppendNSteps(sol, Trapezoidal(), Counting(),
+          args.fixedStepSize, args.tolerance, Bdf<Order>::kNeededSteps);
+      if (result == SolverResult::kOk) {
+        result = NewtonExtendPastMaxTime(sol, Bdf<Order>(), Counting(),
+            args);
+      }
+    });
+    LogResult(result);
+    string name = "Bdf" + to_string(Order) + "(h="
+        + to_string(args.fixedStepSize) + ")";
+    print(args.tolerance, name.c_str(), sol.size() - 1, 0, seconds,
+        sol.t.back(), sol.x.back());
+  }
+
+ private:
+  void print(double tol, const char* name, size_t accepted, size_t rejected,
+      double seconds, double t, const Vectord<N>& x) const {
+    double error = (x - reference(t)).norm();
+    cout << tol << '\t' << name << '\t' << accepted << '\t' << rejected
+         << '\t' << Counting::evaluations << '\t' << Counting::jacobians
+         << '\t' << seconds << '\t' << error << '\n';
+  }
+
+  Vectord<N> reference(double t) const {
+    size_t i = LowerBoundTime(reference_, t);
+    if (reference_.t[i] == t) {
+      return reference_.x[i];
+    }
+    Dv f;
+    double t0 = reference_.t[i-1];
+    double h = reference_.t[i] - t0;
+    const Vectord<N>& x0 = reference_.x[i-1];
+    const Vectord<N>& x1 = reference_.x[i];
+    return DormandPrince853().interpolant(f, t0, x0, f(t0, x0), h,
+        f(t0 + h, x1))(t);
+  }
+
+  Ivp ivp_;
+  StandardOdeSolution<N> reference_;
+};
+
+template <InitialValueProblem Ivp>
+void Compare(Ivp ivp, double highest, double lowest,
+    double referenceTolerance) {
+  StiffWorkPrecision<Ivp> wp(ivp, referenceTolerance);
+  cout << "# tolerance\tmethod\taccepted\trejected\tevaluations"
+       << "\tjacobians\tseconds\terror\n";
+  for (double tol = highest; tol >= lowest*0.99; tol /= 10) {
+    args.tolerance = tol;
+    wp.measure("BdfNordsieck", BdfNordsieck());
+    wp.measure("RadauIIA5", RadauIIA5());
+    wp.measure("Rodas4", Rodas4());
+    wp.measure("Ros3p", Ros3p());
+    wp.measure("Rosenbrock23", Rosenbrock23());
+    wp.measure("Sdirk4", Sdirk4());
+    wp.measure("Esdirk43", Esdirk43());
+    wp.measure("Esdirk32", Esdirk32());
+    wp.measure("TrBdf2", TrBdf2());
+    wp.measure("DormandPrince54", DormandPrince54());
+  }
+  // Newton1d only solves the implicit equations of dimension 1
+  if constexpr (Ivp::Dv::kDim == 1) {
+    args.tolerance = lowest;
+    for (double h = 1e-2; h >= 1e-4; h /= 10) {
+      args.fixedStepSize = h;
+      wp.template measureFixed<2>();
+      wp.template measureFixed<3>();
+      wp.template measureFixed<5>();
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc != 5) {
+    cerr << "Usage: <program> <rigid1|robertson|brusselator> "
+        << "<highest_tolerance> <lowest_tolerance> <reference_tolerance>"
+        << endl;
+    return -1;
+  }
+  double highest = atof(argv[2]);
+  double lowest = atof(argv[3]);
+  double referenceTolerance = atof(argv[4]);
+  args.minStepAllowed = 1e-15;
+  if (strcmp(argv[1], "rigid1") == 0) {
+    args.maxTime = 2;
+    args.maxStepAllowed = 1e-1;
+    Compare(Rigid1(), highest, lowest, referenceTolerance);
+  } else if (strcmp(argv[1], "robertson") == 0) {
+    args.maxTime = 40;
+    args.maxStepAllowed = 10;
+    Compare(Robertson(), highest, lowest, referenceTolerance);
+  } else if (strcmp(argv[1], "brusselator") == 0) {
+    args.maxTime = 10;
+    args.maxStepAllowed = 1;
+    // Fine enough for the explicit methods to be bound by stability
+    Compare(Brusselator<63>(), highest, lowest, referenceTolerance);
+  } else {
+    cerr << "Unknown problem " << argv[1] << endl;
+    return -1;
+  }
+}
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the method you will use in the problem
+#include "methods/rk4.hpp"
+#include "solvers/plain_method_solver.hpp"
+// Include a container for the solution
+#include "solutions/standard_ode_solution.hpp"
+// Include the compressed output
+#include "tools/compressed_trajectory.hpp"
+using namespace std;
+using namespace odelib;
+
+SizeArgs args;
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+const char* Name(TrajectoryPredictor predictor) {
+  switch (predictor) {
+    case TrajectoryPredictor::kPrevious: return "previous";
+    case TrajectoryPredictor::kLinear: return "linear";
+    case TrajectoryPredictor::kDerivative: return "derivative";
+  }
+  return "";
+}
+
+// Compresses an RK4 solution of Arenstorf's problem with every predictor
+// at several tolerances, decompresses it, and reports the compression
+// ratio, the encoding and decoding speeds and the maximum error.
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    cerr << "Usage: <program> <number_of_points>" << endl;
+    return -1;
+  }
+  size_t n = atoll(argv[1]);
+  args.fixedStepSize = 17.0652165601579625588917206249/n;
+  args.maxTime = n*args.fixedStepSize;
+  StandardOdeSolution sol = StandardOdeSolutionFromIvp(Arenstorf());
+  ExtendPastMaxTime(sol, RK4(), Arenstorf::Dv(), args);
+  n = sol.size();
+
+  cout << "# predictor\ttolerance\tratio\tencode (MB/s)\tdecode (MB/s)"
+       << "\tencode (points/s)\tdecode (points/s)\tmax error\n";
+  for (double tolerance : {0.0, 1e-10, 1e-8, 1e-6}) {
+    for (auto predictor : {TrajectoryPredictor::kPrevious,
+        TrajectoryPredictor::kLinear, TrajectoryPredictor::kDerivative}) {
+      bool withDv = predictor == TrajectoryPredictor::kDerivative;
+      double raw = n*sizeof(double)*(withDv? 9 : 5);
+      stringstream stream;
+      double encode = Seconds([&]() {
+        CompressedTrajectoryWriter<4> writer(stream, predictor, tolerance);
+        for (size_t i = 0; i < n; ++i) {
+          if (withDv) {
+            writer.addPoint(sol.t[i], sol.x[i], sol.dv[i]);
+          } else {
+            writer.addPoint(sol.t[i], sol.x[i]);
+          }
+        }
+        writer.onFinished(SolverResult::kOk);
+      });
+      size_t bytes = stream.str().size();
+
+      double err = 0;
+      double decode = Seconds([&]() {
+        CompressedTrajectoryReader<4> reader(stream);
+        double t;
+        Vectord<4> x, dv;
+        for (size_t i = 0; i < n && reader.next(t, x, dv); ++i) {
+          err = max(err, (x - sol.x[i]).cwiseAbs().maxCoeff());
+        }
+      });
+
+      cout << Name(predictor) << '\t' << tolerance << '\t' << raw/bytes
+           << '\t' << raw/encode/1e6 << '\t' << raw/decode/1e6 << '\t'
+           << n/encode << '\t' << n/decode << '\t' << err << '\n';
+    }
+  }
+}
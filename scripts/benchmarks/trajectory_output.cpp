@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+// Select a problem you want to solve
+#include "problems/arenstorf.hpp"
+// Include the method you will use in the problem
+#include "methods/rk4.hpp"
+#include "solvers/plain_method_solver.hpp"
+// Include a container for the solution
+#include "solutions/standard_ode_solution.hpp"
+// Include the outputs to compare
+#include "tools/fast_tsv_output.hpp"
+#include "tools/trajectory_file.hpp"
+#include "tools/tsv_output.hpp"
+using namespace std;
+using namespace odelib;
+
+SizeArgs args;
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+size_t FileSize(const string& path) {
+  ifstream in(path, ios::binary | ios::ate);
+  return in.tellg();
+}
+
+// Writes every point of an RK4 solution of Arenstorf's problem
+// as TSV, as TSV with the fast formatter and as a binary trajectory file,
+// reads them back,
+// and reports the time, the size and the error of the values read.
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    cerr << "Usage: <program> <number_of_points> <output_prefix>" << endl;
+    return -1;
+  }
+  size_t n = atoll(argv[1]);
+  string tsvPath = string(argv[2]) + ".tsv";
+  string fastPath = string(argv[2]) + ".fast.tsv";
+  string binPath = string(argv[2]) + ".odt";
+  args.fixedStepSize = 17.0652165601579625588917206249/n;
+  args.maxTime = n*args.fixedStepSize;
+  StandardOdeSolution sol = StandardOdeSolutionFromIvp(Arenstorf());
+  ExtendPastMaxTime(sol, RK4(), Arenstorf::Dv(), args);
+  n = sol.size();
+
+  double tsvWrite = Seconds([&]() {
+    ofstream out(tsvPath);
+    PrintSolutionWithTime(out, sol, n);
+  });
+  double fastWrite = Seconds([&]() {
+    ofstream out(fastPath);
+    FastPrintSolutionWithTime(out, sol, n);
+  });
+  double binWrite = Seconds([&]() {
+    WriteTrajectory(binPath, sol, "RK4", "Arenstorf");
+  });
+
+  // The readers accumulate the error of the values they read
+  auto readTsv = [&](const string& path, double& err) {
+    ifstream in(path);
+    double t;
+    Vectord<4> x;
+    for (size_t i = 0; i < n && in >> t >> x[0] >> x[1] >> x[2] >> x[3];
+        ++i) {
+      err = max(err, (x - sol.x[i]).norm());
+    }
+  };
+  double tsvErr = 0, fastErr = 0, binErr = 0;
+  double tsvRead = Seconds([&]() { readTsv(tsvPath, tsvErr); });
+  double fastRead = Seconds([&]() { readTsv(fastPath, fastErr); });
+  double binRead = Seconds([&]() {
+    TrajectoryView<4> view;
+    if (!view.open(binPath)) {
+      return;
+    }
+    for (size_t i = 0; i < view.size(); ++i) {
+      binErr = max(binErr, (Vectord<4>(view.x[i]) - sol.x[i]).norm());
+    }
+  });
+
+  cout << "# format\twrite (s)\tread (s)\tsize (bytes)\tmax error\n";
+  cout << "tsv\t" << tsvWrite << '\t' << tsvRead << '\t' << FileSize(tsvPath)
+       << '\t' << tsvErr << '\n';
+  cout << "fast tsv\t" << fastWrite << '\t' << fastRead << '\t'
+       << FileSize(fastPath) << '\t' << fastErr << '\n';
+  cout << "binary\t" << binWrite << '\t' << binRead << '\t'
+       << FileSize(binPath) << '\t' << binErr << '\n';
+  remove(tsvPath.c_str());
+  remove(fastPath.c_str());
+  remove(binPath.c_str());
+}
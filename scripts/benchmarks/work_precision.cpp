@@ -0,0 +1,165 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <limits>
+// Select the problems you want to solve
+#include "problems/arenstorf.hpp"
+#include "problems/two_bodies.hpp"
+// Include the methods to compare
+#include "methods/adams_nordsieck.hpp"
+#include "methods/dormand_prince_54.hpp"
+#include "methods/dormand_prince_853.hpp"
+#include "methods/fehlberg.hpp"
+#include "methods/richardson_extrapolation.hpp"
+#include "methods/rk4.hpp"
+#include "methods/verner_65.hpp"
+#include "methods/verner_76.hpp"
+#include "solvers/nordsieck_method_solver.hpp"
+#include "solvers/plain_adaptive_method_solver.hpp"
+// Include a container for the reference solution and a sink for the points
+#include "solutions/standard_ode_solution.hpp"
+#include "sinks/basic_sinks.hpp"
+using namespace std;
+using namespace odelib;
+
+// A derivative that counts its evaluations
+template <IvpDerivative Dv>
+struct CountingDv {
+  static constexpr int kDim = Dv::kDim;
+
+  inline Vectord<kDim> operator()(double t, const Vectord<kDim>& x) const {
+    ++*evaluations;
+    return f(t, x);
+  }
+
+  Dv f;
+  size_t* evaluations;
+};
+
+template <typename Function>
+double Seconds(Function fun) {
+  auto start = chrono::steady_clock::now();
+  fun();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+SizeArgs args;
+
+// Solves a problem with the methods and compares their last point
+// with a reference solution, interpolated at its time
+// with the dense output of DormandPrince853.
+template <InitialValueProblem Ivp>
+class WorkPrecision {
+ public:
+  using Dv = typename Ivp::Dv;
+  static constexpr int N = Dv::kDim;
+
+  // The reference goes past the maximum time
+  // to contain the last step of every method
+  WorkPrecision(Ivp ivp, double referenceTolerance)
+    : ivp_(ivp), reference_(StandardOdeSolutionFromIvp(ivp)) {
+    SizeArgs refArgs = args;
+    refArgs.tolerance = referenceTolerance;
+    refArgs.maxTime += args.maxStepAllowed;
+    result_ = ExtendPastMaxTime(reference_, DormandPrince853(), Dv(),
+        refArgs);
+    LogResult(result_);
+  }
+
+  // Whether the reference reached the maximum time
+  inline bool ok() const { return result_ == SolverResult::kOk; }
+
+  template <typename Met>
+  void measure(const char* name, const Met& met) {
+    size_t evaluations = 0;
+    LastPointSink<N> last;
+    double seconds = Seconds([&]() {
+      StreamPastMaxTime(ivp_.t0(), ivp_.x0(), met,
+          CountingDv<Dv>{Dv(), &evaluations}, args, last);
+    });
+    LogResult(last.result);
+    double error = (last.x - reference(last.t)).norm();
+    cout << args.tolerance << '\t' << name << '\t' << last.accepted << '\t'
+         << last.rejected << '\t' << evaluations << '\t' << seconds << '\t'
+         << error << '\n';
+  }
+
+ private:
+  Vectord<N> reference(double t) const {
+    size_t i = LowerBoundTime(reference_, t);
+    if (i < reference_.size() && reference_.t[i] == t) {
+      return reference_.x[i];
+    }
+    if (i == 0 || i == reference_.size()) {
+      cerr << "The reference does not reach time " << t << endl;
+      return Vectord<N>::Constant(numeric_limits<double>::quiet_NaN());
+    }
+    Dv f;
+    double t0 = reference_.t[i-1];
+    double h = reference_.t[i] - t0;
+    const Vectord<N>& x0 = reference_.x[i-1];
+    const Vectord<N>& x1 = reference_.x[i];
+    return DormandPrince853().interpolant(f, t0, x0, f(t0, x0), h,
+        f(t0 + h, x1))(t);
+  }
+
+  Ivp ivp_;
+  StandardOdeSolution<N> reference_;
+  SolverResult result_;
+};
+
+template <InitialValueProblem Ivp>
+bool Compare(Ivp ivp, double highest, double lowest,
+    double referenceTolerance) {
+  WorkPrecision<Ivp> wp(ivp, referenceTolerance);
+  if (!wp.ok()) {
+    cerr << "Cannot compute the reference solution" << endl;
+    return false;
+  }
+  cout << "# tolerance\tmethod\taccepted\trejected\tevaluations\tseconds"
+       << "\terror\n";
+  for (double tol = highest; tol >= lowest*0.99; tol /= 10) {
+    args.tolerance = tol;
+    wp.measure("Fehlberg", Fehlberg());
+    wp.measure("Richardson<RK4>", RichardsonExtrapolation<RK4>());
+    wp.measure("DormandPrince54", DormandPrince54());
+    wp.measure("Verner65", Verner65());
+    wp.measure("Verner76", Verner76());
+    wp.measure("DormandPrince853", DormandPrince853());
+    wp.measure("AdamsNordsieck", AdamsNordsieck());
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  if (argc != 5) {
+    cerr << "Usage: <program> <arenstorf|two_bodies> <highest_tolerance> "
+        << "<lowest_tolerance> <reference_tolerance>" << endl;
+    return -1;
+  }
+  double highest = atof(argv[2]);
+  double lowest = atof(argv[3]);
+  double referenceTolerance = atof(argv[4]);
+  // The Nordsieck methods start at order 1,
+  // which takes very small steps at low tolerances
+  args.minStepAllowed = 1e-15;
+  bool ok;
+  if (strcmp(argv[1], "arenstorf") == 0) {
+    // It starts near the Earth, where the rounding of the stages
+    // bounds the estimates of the high order methods by about 1e-11 per
+    // unit step, so the errors stop improving below that
+    args.maxTime = 17.0652165601579625588917206249;
+    args.maxStepAllowed = 1e-1;
+    ok = Compare(Arenstorf(), highest, lowest, referenceTolerance);
+  } else if (strcmp(argv[1], "two_bodies") == 0) {
+    // About one orbit
+    args.maxTime = 9000;
+    args.maxStepAllowed = 100;
+    ok = Compare(TwoBodies(), highest, lowest, referenceTolerance);
+  } else {
+    cerr << "Unknown problem " << argv[1] << endl;
+    return -1;
+  }
+  return ok? 0 : -2;
+}
@@ -0,0 +1,47 @@
+#include <iostream>
+// Select a problem you want to solve
+#include "problems/two_bodies.hpp"
+// Include the method you will use in the problem
+#include "methods/adams_bashforth_4.hpp"
+#include "methods/rk4.hpp"
+#include "solvers/plain_multistep_method_solver.hpp"
+// Include a container for the solution
+#include "solutions/history_window.hpp"
+#include "sinks/basic_sinks.hpp"
+using namespace std;
+using namespace odelib;
+using Dv = TwoBodies::Dv;
+
+SizeArgs args;
+
+// Integrates for as long as desired keeping only the history
+// the method needs, and prints a snapshot every given number of steps.
+int main(int argc, char** argv) {
+  if (argc != 4) {
+    cerr << "Usage: <program> <max_time> <step_size> <steps_per_snapshot>"
+        << endl;
+    return -1;
+  }
+  args.maxTime = atof(argv[1]);
+  args.fixedStepSize = atof(argv[2]);
+  long long every = atoll(argv[3]);
+  auto window = HistoryWindowFromIvp<AdamsBashforth4::kNeededSteps + 1>(
+      TwoBodies());
+
+  long long count = 0;
+  CallbackSink snapshot{[&](double t, const Vectord<4>& x) {
+    if (count++ % every == 0) {
+      cout << t << '\t' << x[0] << '\t' << x[1] << '\n';
+    }
+  }};
+  AppendNSteps(window, RK4(), Dv(), args.fixedStepSize,
+      AdamsBashforth4::kNeededSteps, snapshot);
+  auto result = ExtendPastMaxTime(window, AdamsBashforth4(), Dv(), args,
+      snapshot);
+  window.drain(snapshot);
+  snapshot.onFinished(result);
+  if (result != SolverResult::kOk) {
+    LogResult(result);
+    return -2;
+  }
+}
@@ -4,6 +4,8 @@
 #include "problems/two_bodies.hpp"
 #include "problems/rigid1.hpp"
 #include "problems/taylor1.hpp"
+#include "problems/robertson.hpp"
+#include "problems/brusselator.hpp"
 
 namespace odelib {
 
@@ -11,8 +13,15 @@ static_assert(InitialValueProblem<Arenstorf>);
 static_assert(InitialValueProblem<TwoBodies>);
 static_assert(InitialValueProblem<Rigid1>);
 static_assert(InitialValueProblem<Taylor1>);
+static_assert(InitialValueProblem<Robertson>);
+static_assert(InitialValueProblem<Brusselator<>>);
 
 static_assert(SpaceDerivableIvpDerivative<Rigid1::Dv>);
+static_assert(SpaceDerivableIvpDerivative<Robertson::Dv>);
+static_assert(SpaceDerivableIvpDerivative<Brusselator<>::Dv>);
+static_assert(TimeDerivableIvpDerivative<Rigid1::Dv>);
+static_assert(TimeDerivableIvpDerivative<Robertson::Dv>);
+static_assert(!TimeDerivableIvpDerivative<Arenstorf::Dv>);
 static_assert(NDerivableIvpDerivative<Taylor1::Dv>);
 
 }  // namespace odelib
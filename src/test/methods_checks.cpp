@@ -4,18 +4,38 @@
 #include "methods/interfaces/adaptive_multistep_method.hpp"
 #include "methods/interfaces/plain_implicit_method.hpp"
 #include "methods/interfaces/backward_differentiation_formula.hpp"
+#include "methods/interfaces/dense_output_method.hpp"
+#include "methods/interfaces/nordsieck_method.hpp"
 
 #include "methods/euler.hpp"
 #include "methods/mod_euler.hpp"
 #include "methods/rk4.hpp"
+#include "methods/ssprk3.hpp"
 #include "methods/taylor.hpp"
 #include "methods/richardson_extrapolation.hpp"
 #include "methods/fehlberg.hpp"
+#include "methods/dormand_prince_54.hpp"
+#include "methods/dormand_prince_853.hpp"
+#include "methods/verner_65.hpp"
+#include "methods/verner_76.hpp"
+#include "methods/williamson_3.hpp"
+#include "methods/carpenter_kennedy_4.hpp"
+#include "methods/ssprk104.hpp"
 #include "methods/adams_bashforth_4.hpp"
 #include "methods/predictor_corrector_4.hpp"
 #include "methods/backwards_euler.hpp"
 #include "methods/trapezoidal.hpp"
 #include "methods/backward_differentiation_formulas.hpp"
+#include "methods/adams_nordsieck.hpp"
+#include "methods/bdf_nordsieck.hpp"
+#include "methods/ros3p.hpp"
+#include "methods/rodas4.hpp"
+#include "methods/rosenbrock_23.hpp"
+#include "methods/radau_iia_5.hpp"
+#include "methods/tr_bdf2.hpp"
+#include "methods/esdirk_32.hpp"
+#include "methods/esdirk_43.hpp"
+#include "methods/sdirk_4.hpp"
 
 #include "problems/arenstorf.hpp"
 #include "problems/taylor1.hpp"
@@ -28,10 +48,54 @@ static_assert(PlainMethod<Euler>);
 static_assert(PlainMethod<ModEuler>);
 static_assert(PlainMethod<RK4>);
 static_assert(PlainMethod<Taylor<3>>);
+static_assert(PlainMethod<SSPRK3>);
+static_assert(PlainMethod<Fehlberg>);
+static_assert(PlainMethod<ExplicitRungeKutta<RK4Tableau>>);
+static_assert(PlainMethod<Williamson3>);
+static_assert(PlainMethod<CarpenterKennedy4>);
+static_assert(PlainMethod<SSPRK104>);
+
+// InPlace
+static_assert(InPlaceMethod<Williamson3>);
+static_assert(InPlaceMethod<CarpenterKennedy4>);
+static_assert(InPlaceMethod<SSPRK104>);
+static_assert(!InPlaceMethod<RK4>);
 
 // PlainAdaptive
 static_assert(PlainAdaptiveMethod<RichardsonExtrapolation<Euler>>);
 static_assert(PlainAdaptiveMethod<Fehlberg>);
+static_assert(PlainAdaptiveMethod<ExplicitRungeKutta<FehlbergTableau>>);
+static_assert(!PlainAdaptiveMethod<RK4>);
+static_assert(FsalAdaptiveMethod<DormandPrince54>);
+static_assert(!FsalAdaptiveMethod<Fehlberg>);
+static_assert(PlainAdaptiveMethod<DormandPrince853>);
+static_assert(FsalAdaptiveMethod<Verner65>);
+static_assert(PlainAdaptiveMethod<Verner76>);
+static_assert(!FsalAdaptiveMethod<Verner76>);
+static_assert(PlainAdaptiveMethod<Ros3p>);
+static_assert(PlainAdaptiveMethod<Rodas4, Rigid1::Dv>);
+static_assert(!FsalAdaptiveMethod<Rodas4>);
+static_assert(FsalAdaptiveMethod<Rosenbrock23>);
+static_assert(CachingAdaptiveMethod<RadauIIA5>);
+static_assert(CachingAdaptiveMethod<RadauIIA5, Rigid1::Dv>);
+static_assert(CachingAdaptiveMethod<Rodas4, Rigid1::Dv>);
+static_assert(CachingAdaptiveMethod<Rosenbrock23>);
+static_assert(CachingAdaptiveMethod<TrBdf2>);
+static_assert(CachingAdaptiveMethod<Esdirk32>);
+static_assert(CachingAdaptiveMethod<Esdirk43, Rigid1::Dv>);
+static_assert(CachingAdaptiveMethod<Sdirk4, Rigid1::Dv>);
+
+// DenseOutput
+static_assert(DenseOutputMethod<RK4>);
+static_assert(DenseOutputMethod<Fehlberg>);
+static_assert(DenseOutputMethod<DormandPrince54>);
+static_assert(DenseOutputMethod<DormandPrince853>);
+static_assert(DenseOutputMethod<Verner65>);
+static_assert(DenseOutputMethod<Verner76>);
+static_assert(DenseOutputMethod<Ros3p>);
+static_assert(DenseOutputMethod<Rodas4>);
+static_assert(DenseOutputMethod<Rosenbrock23>);
+static_assert(!DenseOutputMethod<Euler>);
 
 // PlainMultistep
 static_assert(PlainMultistepMethod<AdamsBashforth4>);
@@ -53,4 +117,10 @@ static_assert(BackwardDifferentiationFormula<Bdf4>);
 static_assert(BackwardDifferentiationFormula<Bdf5>);
 static_assert(BackwardDifferentiationFormula<Bdf6>);
 
+// Nordsieck
+static_assert(NordsieckMethod<AdamsNordsieck<>>);
+static_assert(NordsieckMethod<AdamsNordsieck<5>>);
+static_assert(NordsieckMethod<BdfNordsieck<>>);
+static_assert(NordsieckMethod<BdfNordsieck<>, Rigid1::Dv>);
+
 }  // namespace odelib
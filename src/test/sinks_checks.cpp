@@ -0,0 +1,27 @@
+#include "solution_sink.hpp"
+
+#include "sinks/async_sink.hpp"
+#include "sinks/basic_sinks.hpp"
+#include "sinks/thinning_sink.hpp"
+#include "sinks/tsv_sink.hpp"
+#include "problems/arenstorf.hpp"
+#include "solutions/standard_ode_solution.hpp"
+#include "tools/compressed_trajectory.hpp"
+
+namespace odelib {
+
+static_assert(SolutionSink<DiscardSink, 1>);
+static_assert(SolutionSink<DiscardSink, 4>);
+static_assert(SolutionSink<LastPointSink<4>, 4>);
+static_assert(SolutionSink<EveryKthPointSink<4, LastPointSink<4>>, 4>);
+static_assert(SolutionSink<CallbackSink<void (*)(double, const Vectord<4>&)>,
+    4>);
+static_assert(SolutionSink<AppendToSolution<StandardOdeSolution<4>>, 4>);
+static_assert(SolutionSink<
+    ThinningSink<StandardOdeSolution<4>, Arenstorf::Dv>, 4>);
+static_assert(SolutionSink<CompressedTrajectoryWriter<4>, 4>);
+static_assert(SolutionSink<TsvSink<4>, 4>);
+static_assert(SolutionSink<AsyncSink<4, LastPointSink<4>>, 4>);
+static_assert(SolutionSink<AsyncSink<4, TsvSink<4>&>, 4>);
+
+}  // namespace odelib
@@ -0,0 +1,36 @@
+#include "ode_solution.hpp"
+
+#include "solutions/standard_ode_solution.hpp"
+#include "solutions/chunked_ode_solution.hpp"
+#include "solutions/derivative_free_ode_solution.hpp"
+#include "solutions/history_window.hpp"
+#include "solutions/mapped_ode_solution.hpp"
+#include "tools/trajectory_file.hpp"
+
+namespace odelib {
+
+static_assert(OdeSolution<StandardOdeSolution<1>>);
+static_assert(OdeSolution<StandardOdeSolution<4>>);
+
+static_assert(OdeSolution<ChunkedOdeSolution<4, SolutionLayout::kSoA>>);
+static_assert(OdeSolution<ChunkedOdeSolution<4, SolutionLayout::kAoSoA>>);
+static_assert(OdeSolution<ChunkedOdeSolution<1, SolutionLayout::kAoSoA, 8>>);
+
+static_assert(OdeSolution<DerivativeFreeOdeSolution<4>>);
+
+static_assert(OdeSolution<MappedOdeSolution<4>>);
+
+static_assert(OdeSolution<TrajectoryView<4>>);
+static_assert(OdeSolution<TrajectoryView<4, SolutionLayout::kAoSoA, 64>>);
+static_assert(OdeSolution<TrajectoryView<4, SolutionLayout::kSoA, 64, false>>);
+
+static_assert(OdeSolutionWithDerivatives<StandardOdeSolution<4>>);
+static_assert(OdeSolutionWithDerivatives<ChunkedOdeSolution<4>>);
+static_assert(!OdeSolutionWithDerivatives<DerivativeFreeOdeSolution<4>>);
+static_assert(OdeSolutionWithDerivatives<HistoryWindow<4, 4>>);
+static_assert(OdeSolutionWithDerivatives<MappedOdeSolution<4>>);
+static_assert(OdeSolutionWithDerivatives<TrajectoryView<4>>);
+static_assert(!OdeSolutionWithDerivatives<
+    TrajectoryView<4, SolutionLayout::kSoA, 4096, false>>);
+
+}  // namespace odelib
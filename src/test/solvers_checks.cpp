@@ -0,0 +1,28 @@
+#include "solvers/step_size_controllers.hpp"
+
+#include "methods/dormand_prince_54.hpp"
+#include "methods/esdirk_43.hpp"
+#include "methods/euler.hpp"
+#include "methods/predictor_corrector_4.hpp"
+#include "methods/richardson_extrapolation.hpp"
+#include "methods/ros3p.hpp"
+
+namespace odelib {
+
+// StepSizeController
+static_assert(StepSizeController<ElementaryController>);
+static_assert(StepSizeController<GustafssonPIController>);
+static_assert(StepSizeController<PredictivePIController>);
+static_assert(StepSizeController<H211PIController>);
+static_assert(StepSizeController<H211bController>);
+static_assert(StepSizeController<H312PIDController>);
+
+// ErrorOrder and RatioOrder
+static_assert(ErrorOrder<DormandPrince54>() == 4);
+static_assert(ErrorOrder<RichardsonExtrapolation<Euler>>() == 1);
+static_assert(ErrorOrder<PredictorCorrector4<>>() == 4);
+static_assert(RatioOrder<DormandPrince54>() == 4);
+static_assert(RatioOrder<Ros3p>() == 3);
+static_assert(RatioOrder<Esdirk43>() == 4);
+
+}  // namespace odelib